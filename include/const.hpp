@@ -3,7 +3,28 @@
 #define UPDATE_LOOP_FREQUENCY_HZ 250
 
 #define CRSF_BAUDRATE 420000
+// Rate proposed to the receiver once the link is up, set to CRSF_BAUDRATE to disable negotiation
+#define CRSF_MAX_BAUDRATE 921600
 #define CRSF_RX_PIN 1
 #define CRSF_TX_PIN 0
+// UART behind Serial0, which the CRSF receiver is connected to
+#define CRSF_UART_NUM UART_NUM_0
+
+// Wake the control task from the CRSF UART when a complete frame has arrived
+// instead of polling at UPDATE_LOOP_FREQUENCY_HZ. The loop interval is then
+// only used as a timeout so failsafe keeps running while the link is silent.
+#define CRSF_EVENT_DRIVEN 1
+// UART idle time (in symbols) that marks the end of a CRSF frame
+#define CRSF_RX_IDLE_SYMBOLS 2
+
+// With aligned output commits PWM duties are held back until their timer's period ends
+// within this time, so a pulse carries the newest value that could still make it
+#define OUTPUT_COMMIT_LEAD_US 2000
+
+// Default time without RC frames before outputs go to failsafe
+#define FAILSAFE_FRAME_GAP_MS 100
+
+// Handlers a configuration can hold, storage for them is reserved statically
+#define MAX_CHANNEL_HANDLERS 20
 
 #define WIFI_ENABLE_TIMEOUT 10000
@@ -8,19 +8,22 @@ struct PinInfo
 {
     uint8_t pin;
     bool isPWM;
+    bool isADC; // Routed to ADC1, can be sampled as a sensor
 };
 
 // ESP32-C3 SuperMini pin mapping
 #ifdef BOARD_ESP32C3_SUPERMINI
 const std::map<std::string, PinInfo> PIN_MAP = {
-    {"STEERING", {6, true}},
-    {"THROTTLE", {5, true}},
-    {"HEADLIGHT", {9, true}},
-    {"BLINKER_LEFT", {10, true}},
-    {"BLINKER_RIGHT", {20, true}},
-    {"BRAKE_LIGHT", {21, true}},
-    {"WINCH_1", {7, true}},
-    {"WINCH_2", {8, true}}};
+    {"STEERING", {6, true, false}},
+    {"THROTTLE", {5, true, false}},
+    {"HEADLIGHT", {9, true, false}},
+    {"BLINKER_LEFT", {10, true, false}},
+    {"BLINKER_RIGHT", {20, true, false}},
+    {"BRAKE_LIGHT", {21, true, false}},
+    {"WINCH_1", {7, true, false}},
+    {"WINCH_2", {8, true, false}},
+    {"AUX_1", {3, true, true}},
+    {"AUX_2", {4, true, true}}};
 
 #else
 #error "No board type defined! Please select a board type in platformio.ini"
@@ -0,0 +1,22 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "logger.hpp"
+
+void runBenchmarks()
+{
+    LOG.infof("Benchmarks", "Running benchmarks at %d MHz", getCpuFrequencyMhz());
+
+    runCrsfDecoderBenchmark();
+    runInputDecoderBenchmark();
+    runHandlerArenaBenchmark();
+    runThresholdBenchmark();
+    runMixerBenchmark();
+    runLogicBenchmark();
+    runPatternBenchmark();
+    runWs2812Benchmark();
+
+    LOG.info("Benchmarks", "Benchmarks complete");
+}
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include <Arduino.h>
+
+/**
+ * @brief Run all on-device benchmarks and log their results
+ * Only compiled into the esp32-c3-supermini-benchmarks environment.
+ */
+void runBenchmarks();
+
+void runCrsfDecoderBenchmark();
+void runInputDecoderBenchmark();
+void runHandlerArenaBenchmark();
+void runThresholdBenchmark();
+void runMixerBenchmark();
+void runLogicBenchmark();
+void runPatternBenchmark();
+void runWs2812Benchmark();
+
+/**
+ * @brief Stream that plays back a fixed byte buffer, used to feed recorded input into decoders
+ */
+class ReplayStream : public Stream
+{
+public:
+    ReplayStream(const uint8_t *data, size_t length) : data(data), length(length), position(0) {}
+
+    void rewind() { position = 0; }
+
+    int available() override { return length - position; }
+    int read() override { return position < length ? data[position++] : -1; }
+    int peek() override { return position < length ? data[position] : -1; }
+    size_t readBytes(char *buffer, size_t count) override
+    {
+        count = min(count, length - position);
+        memcpy(buffer, data + position, count);
+        position += count;
+        return count;
+    }
+    size_t write(uint8_t) override { return 1; }
+    void flush() override {}
+
+private:
+    const uint8_t *data;
+    size_t length;
+    size_t position;
+};
+
+#endif
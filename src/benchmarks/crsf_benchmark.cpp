@@ -0,0 +1,57 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "crsf_sample_stream.hpp"
+#include "crsf/crsf_decoder.hpp"
+#include "bordcomputer.hpp"
+#include "logger.hpp"
+#include <AlfredoCRSF.h>
+
+static const int CRSF_BENCHMARK_PASSES = 200;
+
+void runCrsfDecoderBenchmark()
+{
+    ReplayStream stream(CRSF_SAMPLE_STREAM, sizeof(CRSF_SAMPLE_STREAM));
+
+    // In-tree decoder
+    uint16_t channels[CRSF_RC_CHANNEL_COUNT] = {0};
+    CrsfDecoder decoder;
+    decoder.begin(stream, channels);
+
+    uint32_t startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < CRSF_BENCHMARK_PASSES; pass++)
+    {
+        stream.rewind();
+        decoder.update();
+    }
+    uint32_t decoderCycles = ESP.getCycleCount() - startCycles;
+
+    // AlfredoCRSF library on the same bytes
+    AlfredoCRSF library;
+    library.begin(stream);
+
+    startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < CRSF_BENCHMARK_PASSES; pass++)
+    {
+        stream.rewind();
+        library.update();
+    }
+    uint32_t libraryCycles = ESP.getCycleCount() - startCycles;
+
+    // Both decoders should end on the same channel values (library output is not clamped)
+    int maxDifference = 0;
+    for (int i = 0; i < CRSF_RC_CHANNEL_COUNT; i++)
+    {
+        int expected = constrain(library.getChannel(i + 1), CHANNEL_MIN, CHANNEL_MAX);
+        maxDifference = max(maxDifference, abs(expected - (int)channels[i]));
+    }
+
+    const uint32_t frames = CRSF_SAMPLE_RC_FRAMES * CRSF_BENCHMARK_PASSES;
+    InputDecoderStats stats = decoder.getStats();
+    LOG.infof("Benchmarks", "CRSF in-tree decoder: %lu cycles/RC frame (%lu frames, %lu CRC errors)",
+              decoderCycles / frames, stats.framesDecoded, stats.crcErrors);
+    LOG.infof("Benchmarks", "CRSF AlfredoCRSF:     %lu cycles/RC frame", libraryCycles / frames);
+    LOG.infof("Benchmarks", "CRSF max channel difference between decoders: %dus", maxDifference);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Sample receiver output: 48 RC_CHANNELS_PACKED frames with sweeping sticks and
+// switching aux channels, interleaved with LINK_STATISTICS frames every 12 frames.
+static const uint8_t CRSF_SAMPLE_STREAM[] = {
+    0xC8, 0x18, 0x16, 0xE0, 0xC3, 0x6E, 0x80, 0x69, 0x08, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67,
+    0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE3, 0xC8, 0x0C, 0x14, 0x3A, 0x3C, 0x64,
+    0x0A, 0x00, 0x04, 0x02, 0x40, 0x64, 0x08, 0xE7, 0xC8, 0x18, 0x16, 0x2A, 0xEC, 0xAF, 0x77, 0xD3,
+    0x07, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C,
+    0x15, 0x3E, 0xC8, 0x18, 0x16, 0x74, 0xCC, 0xB0, 0x6C, 0x3F, 0x07, 0xBE, 0x89, 0xB3, 0x02, 0x7C,
+    0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xC7, 0xC8, 0x18, 0x16, 0xBB,
+    0x64, 0x31, 0x60, 0xAB, 0x06, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE,
+    0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xDB, 0xC8, 0x18, 0x16, 0xFF, 0xB4, 0xF1, 0x51, 0x1B, 0x06, 0xBE,
+    0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xFD,
+    0xC8, 0x18, 0x16, 0x3F, 0xBD, 0x31, 0x42, 0x93, 0x05, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67,
+    0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x03, 0xC8, 0x18, 0x16, 0x78, 0x75, 0x31,
+    0x31, 0x13, 0x05, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0,
+    0x4D, 0x9C, 0x15, 0xAD, 0xC8, 0x18, 0x16, 0xAC, 0xE5, 0xB0, 0x1F, 0x9D, 0x04, 0xBE, 0x89, 0xB3,
+    0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x36, 0xC8, 0x18,
+    0x16, 0xD8, 0x0D, 0x30, 0x0D, 0x33, 0x04, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8,
+    0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x2B, 0xC8, 0x18, 0x16, 0xFD, 0xF5, 0x6E, 0xFA, 0xD8,
+    0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C,
+    0x15, 0xC7, 0xC8, 0x18, 0x16, 0x19, 0x96, 0xED, 0xE7, 0x8E, 0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C,
+    0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xD2, 0xC8, 0x18, 0x16, 0x2C,
+    0x06, 0x6C, 0xD5, 0x52, 0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE,
+    0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x47, 0xC8, 0x18, 0x16, 0x36, 0x3E, 0x6A, 0xC3, 0x2A, 0x03, 0xBE,
+    0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x4C,
+    0xC8, 0x0C, 0x14, 0x3A, 0x3C, 0x64, 0x0A, 0x00, 0x04, 0x02, 0x40, 0x64, 0x08, 0xE7, 0xC8, 0x18,
+    0x16, 0x37, 0x46, 0x68, 0xB2, 0x14, 0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8,
+    0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x36, 0xC8, 0x18, 0x16, 0x2E, 0x26, 0x66, 0xA2, 0x10,
+    0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C,
+    0x15, 0x0F, 0xC8, 0x18, 0x16, 0x1C, 0xF6, 0xA3, 0x93, 0x1E, 0x03, 0xBE, 0x89, 0xB3, 0x02, 0x7C,
+    0x13, 0x67, 0x05, 0xF8, 0x26, 0xCE, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0x8B, 0xC8, 0x18, 0x16, 0x01,
+    0xA6, 0x61, 0x86, 0x40, 0x33, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01,
+    0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x2C, 0xC8, 0x18, 0x16, 0xDE, 0x4D, 0x1F, 0x7B, 0x74, 0x33, 0x71,
+    0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0xA3,
+    0xC8, 0x18, 0x16, 0xB2, 0xFD, 0xDC, 0x71, 0xB8, 0x33, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00,
+    0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x3D, 0xC8, 0x18, 0x16, 0x80, 0xAD, 0x5A,
+    0x6A, 0x0C, 0x34, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89,
+    0xB3, 0x02, 0x7C, 0x3A, 0xC8, 0x18, 0x16, 0x47, 0x6D, 0x58, 0x65, 0x70, 0x34, 0x71, 0x56, 0x80,
+    0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0xB5, 0xC8, 0x18,
+    0x16, 0x08, 0x4D, 0x96, 0x62, 0xE0, 0x34, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4,
+    0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x5E, 0xC8, 0x18, 0x16, 0xC4, 0x4C, 0x14, 0x62, 0x5E,
+    0x35, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02,
+    0x7C, 0xB3, 0xC8, 0x18, 0x16, 0x7E, 0x74, 0xD2, 0x63, 0xE2, 0x35, 0x71, 0x56, 0x80, 0x6F, 0xE2,
+    0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x40, 0xC8, 0x18, 0x16, 0x34,
+    0xCC, 0x10, 0x68, 0x70, 0x36, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01,
+    0xBE, 0x89, 0xB3, 0x02, 0x7C, 0xE5, 0xC8, 0x0C, 0x14, 0x3A, 0x3C, 0x64, 0x0A, 0x00, 0x04, 0x02,
+    0x40, 0x64, 0x08, 0xE7, 0xC8, 0x18, 0x16, 0xE9, 0x63, 0x8F, 0x6E, 0x02, 0x37, 0x71, 0x56, 0x80,
+    0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x56, 0xC8, 0x18,
+    0x16, 0x9F, 0x3B, 0x0E, 0x77, 0x98, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4,
+    0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x15, 0xC8, 0x18, 0x16, 0x55, 0x4B, 0x8D, 0x81, 0x2E,
+    0x38, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02,
+    0x7C, 0x3F, 0xC8, 0x18, 0x16, 0x0D, 0xAB, 0x0C, 0x8E, 0xC2, 0x38, 0x71, 0x56, 0x80, 0x6F, 0xE2,
+    0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x64, 0xC8, 0x18, 0x16, 0xC9,
+    0x52, 0x0C, 0x9C, 0x52, 0x39, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01,
+    0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x83, 0xC8, 0x18, 0x16, 0x89, 0x42, 0xCC, 0xAB, 0xDC, 0x39, 0x71,
+    0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00, 0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x41,
+    0xC8, 0x18, 0x16, 0x4E, 0x7A, 0x4C, 0xBC, 0x5C, 0x3A, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xAC, 0x00,
+    0xDF, 0xC4, 0x59, 0x01, 0xBE, 0x89, 0xB3, 0x02, 0x7C, 0x66, 0xC8, 0x18, 0x16, 0x19, 0x02, 0x0D,
+    0xCE, 0xD4, 0xCA, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56,
+    0x80, 0x6F, 0xE2, 0xFB, 0xC8, 0x18, 0x16, 0xEC, 0xD1, 0x4D, 0xE0, 0x3E, 0xCB, 0x0A, 0xF0, 0x4D,
+    0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x0D, 0xC8, 0x18,
+    0x16, 0xC7, 0xE1, 0x0E, 0xF3, 0x9A, 0xCB, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B,
+    0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x27, 0xC8, 0x18, 0x16, 0xA9, 0x31, 0xD0, 0x05, 0xE9,
+    0xCB, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F,
+    0xE2, 0x2A, 0xC8, 0x18, 0x16, 0x95, 0xC1, 0x51, 0x18, 0x25, 0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15,
+    0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x18, 0xC8, 0x0C, 0x14, 0x3A,
+    0x3C, 0x64, 0x0A, 0x00, 0x04, 0x02, 0x40, 0x64, 0x08, 0xE7, 0xC8, 0x18, 0x16, 0x8A, 0x81, 0x53,
+    0x2A, 0x51, 0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56,
+    0x80, 0x6F, 0xE2, 0x1E, 0xC8, 0x18, 0x16, 0x88, 0x79, 0x95, 0x3B, 0x69, 0xCC, 0x0A, 0xF0, 0x4D,
+    0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x64, 0xC8, 0x18,
+    0x16, 0x8F, 0x89, 0x97, 0x4B, 0x6F, 0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B,
+    0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x14, 0xC8, 0x18, 0x16, 0xA0, 0xC1, 0x99, 0x5A, 0x63,
+    0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F,
+    0xE2, 0x82, 0xC8, 0x18, 0x16, 0xBA, 0x09, 0xDC, 0x67, 0x45, 0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15,
+    0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xE3, 0xC8, 0x18, 0x16, 0xDC,
+    0x61, 0x5E, 0x73, 0x13, 0xCC, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37,
+    0x71, 0x56, 0x80, 0x6F, 0xE2, 0x93, 0xC8, 0x18, 0x16, 0x06, 0xBA, 0x20, 0x7D, 0xD1, 0xCB, 0x0A,
+    0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xEE,
+    0xC8, 0x18, 0x16, 0x38, 0x0A, 0xA3, 0x84, 0x7F, 0xCB, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B,
+    0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x3A, 0xC8, 0x18, 0x16, 0x70, 0x4A, 0x25,
+    0x8A, 0x1D, 0xCB, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56,
+    0x80, 0x6F, 0xE2, 0x1E, 0xC8, 0x18, 0x16, 0xAF, 0x72, 0x27, 0x8D, 0xAD, 0xCA, 0x0A, 0xF0, 0x4D,
+    0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0xCA, 0xC8, 0x18,
+    0x16, 0xF1, 0x72, 0xE9, 0x8D, 0x33, 0xCA, 0x0A, 0xF0, 0x4D, 0x9C, 0x15, 0xE0, 0x9B, 0x38, 0x2B,
+    0xC0, 0x37, 0x71, 0x56, 0x80, 0x6F, 0xE2, 0x4C};
+
+static const size_t CRSF_SAMPLE_RC_FRAMES = 48;
@@ -0,0 +1,74 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "bordcomputer.hpp"
+#include "config_manager.hpp"
+#include "logger.hpp"
+
+static const int RECONFIGURATIONS = 1000;
+
+static void addHandler(Config &config, const char *type, const char *pin, uint8_t channel)
+{
+    HandlerConfig &handler = config.handlers[config.numHandlers++];
+    handler.setType(type);
+    handler.setPin(pin);
+    handler.setOp("greaterThan");
+    handler.channel = channel;
+    handler.failsafe = CHANNEL_MIN;
+    handler.min = CHANNEL_MIN;
+    handler.max = CHANNEL_MAX;
+}
+
+void runHandlerArenaBenchmark()
+{
+    // Separate instances, the real board computer is not configured yet
+    static BoardComputer computer(&Serial1);
+    static EEPROMManager eeprom;
+    static ConfigManager configManager(&computer, &eeprom);
+
+    // Static, two configs do not fit on the stack next to each other
+    static Config full;
+    addHandler(full, "pwm", "STEERING", 1);
+    addHandler(full, "pwm", "THROTTLE", 2);
+    addHandler(full, "onoff", "HEADLIGHT", 5);
+    addHandler(full, "onoff", "BRAKE_LIGHT", 6);
+    addHandler(full, "blink", "BLINKER_LEFT", 7);
+    addHandler(full, "blink", "BLINKER_RIGHT", 8);
+
+    // Alternating with an empty config constructs and destroys every handler each time
+    static Config empty;
+    const Config *configs[] = {&full, &empty};
+
+    LOG.setLogLevel(LogLevel::ERROR);
+
+    // Warm up once so lazily allocated driver state is not counted
+    configManager.configure(full);
+    configManager.configure(empty);
+
+    uint32_t heapBefore = ESP.getFreeHeap();
+    uint32_t largestBlockBefore = ESP.getMaxAllocHeap();
+    uint32_t startMs = millis();
+
+    int failures = 0;
+    for (int i = 0; i < RECONFIGURATIONS; i++)
+    {
+        if (!configManager.configure(*configs[i & 1]))
+        {
+            failures++;
+        }
+    }
+
+    uint32_t elapsedMs = millis() - startMs;
+    configManager.configure(empty);
+    uint32_t heapAfter = ESP.getFreeHeap();
+    uint32_t largestBlockAfter = ESP.getMaxAllocHeap();
+
+    LOG.setLogLevel(LogLevel::DEBUG);
+
+    LOG.infof("Benchmarks", "Handler arena: %d reconfigurations in %lums (%d failed), %d/%d slots in use",
+              RECONFIGURATIONS, elapsedMs, failures, computer.getHandlerArena().used(), computer.getHandlerArena().capacity());
+    LOG.infof("Benchmarks", "Handler arena: free heap %lu -> %lu bytes, largest block %lu -> %lu bytes",
+              heapBefore, heapAfter, largestBlockBefore, largestBlockAfter);
+}
+
+#endif
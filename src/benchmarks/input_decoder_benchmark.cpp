@@ -0,0 +1,72 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "input_sample_streams.hpp"
+#include "inputs/sbus_decoder.hpp"
+#include "inputs/ibus_decoder.hpp"
+#include "inputs/ppm_decoder.hpp"
+#include "logger.hpp"
+
+static const int INPUT_BENCHMARK_PASSES = 200;
+
+template <typename Decoder>
+static uint32_t benchmarkSerialDecoder(const char *name, const uint8_t *data, size_t length, uint16_t *channels)
+{
+    ReplayStream stream(data, length);
+    Decoder decoder;
+    decoder.begin(stream, channels);
+
+    uint32_t startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < INPUT_BENCHMARK_PASSES; pass++)
+    {
+        stream.rewind();
+        decoder.update();
+    }
+    uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+    InputDecoderStats stats = decoder.getStats();
+    LOG.infof("Benchmarks", "%s decoder: %lu cycles/frame, %lu bytes/Mcycle (%lu frames, %lu errors, %lu bytes discarded)", name,
+              cycles / (INPUT_SAMPLE_FRAMES * INPUT_BENCHMARK_PASSES),
+              (uint32_t)((uint64_t)length * INPUT_BENCHMARK_PASSES * 1000000 / cycles),
+              stats.framesDecoded, stats.crcErrors, stats.bytesDiscarded);
+    return stats.framesDecoded;
+}
+
+void runInputDecoderBenchmark()
+{
+    uint16_t sbusChannels[INPUT_MAX_CHANNELS] = {0};
+    uint16_t ibusChannels[INPUT_MAX_CHANNELS] = {0};
+    uint16_t ppmChannels[INPUT_MAX_CHANNELS] = {0};
+
+    benchmarkSerialDecoder<SbusDecoder>("SBUS", SBUS_SAMPLE_STREAM, sizeof(SBUS_SAMPLE_STREAM), sbusChannels);
+    benchmarkSerialDecoder<IbusDecoder>("iBUS", IBUS_SAMPLE_STREAM, sizeof(IBUS_SAMPLE_STREAM), ibusChannels);
+
+    // PPM frames are decoded by the capture task straight from the RMT items
+    const rmt_item32_t *items = reinterpret_cast<const rmt_item32_t *>(PPM_SAMPLE_ITEMS);
+    uint32_t ppmFrames = 0;
+    uint32_t startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < INPUT_BENCHMARK_PASSES; pass++)
+    {
+        for (size_t frame = 0; frame < INPUT_SAMPLE_FRAMES; frame++)
+        {
+            if (PpmDecoder::decodeFrame(items + frame * PPM_SAMPLE_ITEMS_PER_FRAME, PPM_SAMPLE_ITEMS_PER_FRAME, ppmChannels) > 0)
+            {
+                ppmFrames++;
+            }
+        }
+    }
+    uint32_t ppmCycles = ESP.getCycleCount() - startCycles;
+    LOG.infof("Benchmarks", "PPM decoder: %lu cycles/frame (%lu frames)",
+              ppmCycles / (INPUT_SAMPLE_FRAMES * INPUT_BENCHMARK_PASSES), ppmFrames);
+
+    // All three streams end on the same sticks, SBUS only resolves them to about a microsecond
+    int maxDifference = 0;
+    for (int i = 0; i < INPUT_SAMPLE_CHANNELS; i++)
+    {
+        maxDifference = max(maxDifference, abs((int)sbusChannels[i] - (int)ppmChannels[i]));
+        maxDifference = max(maxDifference, abs((int)ibusChannels[i] - (int)ppmChannels[i]));
+    }
+    LOG.infof("Benchmarks", "Input max channel difference between protocols: %dus", maxDifference);
+}
+
+#endif
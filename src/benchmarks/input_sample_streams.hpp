@@ -0,0 +1,247 @@
+#pragma once
+
+#include <Arduino.h>
+
+// The same 48 frames of stick movement as three receivers send them: sweeping sticks on
+// channels 1 to 3 and aux switches on 5 to 8 that flip every 12 frames.
+#define INPUT_SAMPLE_FRAMES 48
+// Channels every sample carries, PPM stops after 8
+#define INPUT_SAMPLE_CHANNELS 8
+
+// SBUS frames as the UART delivers them after inverting, no flags set
+static const uint8_t SBUS_SAMPLE_STREAM[] = {
+    0x0F, 0xE0, 0x03, 0x38, 0x30, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8,
+    0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x48, 0xD4, 0xB7, 0x38, 0xC0, 0x07,
+    0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C,
+    0x00, 0x00, 0x0F, 0xAF, 0x2C, 0x77, 0x41, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03,
+    0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x12, 0x25, 0xF6, 0x49,
+    0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81,
+    0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x70, 0xAD, 0x34, 0x52, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0,
+    0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC7, 0xE5,
+    0xB2, 0x5A, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E,
+    0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x17, 0xBE, 0x70, 0x63, 0xC0, 0x07, 0x0C, 0x80, 0x03,
+    0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F,
+    0x5C, 0x3E, 0xEE, 0x6B, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0,
+    0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x95, 0x86, 0x2B, 0x74, 0xC0, 0x07, 0x0C,
+    0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00,
+    0x00, 0x0F, 0xC4, 0x96, 0xA8, 0x7C, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F,
+    0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xE5, 0x7E, 0x65, 0x85, 0xC0,
+    0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F,
+    0x7C, 0x00, 0x00, 0x0F, 0xFA, 0x46, 0xE2, 0x8D, 0xC0, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0,
+    0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x00, 0x07, 0x1F,
+    0x96, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0,
+    0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xFA, 0xC6, 0x1B, 0x9F, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C,
+    0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xE5,
+    0x96, 0x58, 0xA7, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07,
+    0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC4, 0x7E, 0xD5, 0xAF, 0xC0, 0x07, 0x70, 0x60,
+    0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00,
+    0x0F, 0x95, 0x86, 0x12, 0xB8, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8,
+    0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x5C, 0xD6, 0x0F, 0xC1, 0xC0, 0x07,
+    0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C,
+    0x00, 0x00, 0x0F, 0x17, 0x56, 0x4D, 0xC9, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03,
+    0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC7, 0x2D, 0xCB, 0xD1,
+    0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81,
+    0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x70, 0x65, 0x89, 0xDA, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18,
+    0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x12, 0xED,
+    0x07, 0xE3, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E,
+    0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xAF, 0xE4, 0x46, 0xEB, 0xC0, 0x07, 0x70, 0x60, 0x00,
+    0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F,
+    0x48, 0x3C, 0xC6, 0xF3, 0xC0, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0,
+    0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xE0, 0x03, 0x86, 0xFC, 0xC0, 0x07, 0x0C,
+    0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00,
+    0x00, 0x0F, 0x78, 0x3B, 0x06, 0x05, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F,
+    0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x12, 0xE3, 0x46, 0x0D, 0xC1,
+    0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F,
+    0x7C, 0x00, 0x00, 0x0F, 0xAF, 0xEA, 0xC7, 0x15, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0,
+    0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x50, 0x62, 0x89,
+    0x1E, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0,
+    0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xFA, 0x29, 0x0B, 0x27, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03,
+    0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xAA,
+    0x51, 0x4D, 0x2F, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07,
+    0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x65, 0xD1, 0x0F, 0x38, 0xC1, 0x07, 0x0C, 0x80,
+    0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00,
+    0x0F, 0x2C, 0x81, 0x92, 0x40, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8,
+    0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xFD, 0x78, 0x15, 0x49, 0xC1, 0x07,
+    0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C,
+    0x00, 0x00, 0x0F, 0xDC, 0x90, 0x58, 0x51, 0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03,
+    0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC7, 0xC0, 0x1B, 0x5A,
+    0xC1, 0x07, 0x0C, 0x80, 0x03, 0x03, 0xE0, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81,
+    0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC0, 0x00, 0x9F, 0x62, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18,
+    0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xC7, 0x40,
+    0x22, 0x6B, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E,
+    0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xDC, 0x78, 0xE5, 0x73, 0xC1, 0x07, 0x70, 0x60, 0x00,
+    0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F,
+    0xFD, 0x90, 0x28, 0x7C, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0,
+    0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x2C, 0x81, 0xAB, 0x84, 0xC1, 0x07, 0x70,
+    0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00,
+    0x00, 0x0F, 0x65, 0x39, 0x2E, 0x8D, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F,
+    0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xAA, 0xB9, 0xF0, 0x95, 0xC1,
+    0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F,
+    0x7C, 0x00, 0x00, 0x0F, 0xFA, 0xE1, 0x32, 0x9E, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0,
+    0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x50, 0xAA, 0xB4,
+    0xA6, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0,
+    0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0xAF, 0x22, 0x36, 0xAF, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C,
+    0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x12,
+    0x2B, 0xF7, 0xB7, 0xC1, 0x07, 0x70, 0x60, 0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07,
+    0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00, 0x0F, 0x78, 0xD3, 0x37, 0xC0, 0xC1, 0x07, 0x70, 0x60,
+    0x00, 0x1C, 0x18, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00,
+};
+
+// iBUS servo frames with 14 channels
+static const uint8_t IBUS_SAMPLE_STREAM[] = {
+    0x20, 0x40, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x51, 0xF3,
+    0x20, 0x40, 0x1D, 0x06, 0xCC, 0x07, 0xFD, 0x03, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xFE, 0xF3,
+    0x20, 0x40, 0x5D, 0x06, 0xBF, 0x07, 0x13, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xB4, 0xF4,
+    0x20, 0x40, 0x9B, 0x06, 0xAA, 0x07, 0x28, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x76, 0xF4,
+    0x20, 0x40, 0xD6, 0x06, 0x8D, 0x07, 0x3D, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x43, 0xF4,
+    0x20, 0x40, 0x0C, 0x07, 0x69, 0x07, 0x52, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x1B, 0xF5,
+    0x20, 0x40, 0x3E, 0x07, 0x3E, 0x07, 0x68, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xFE, 0xF4,
+    0x20, 0x40, 0x69, 0x07, 0x0C, 0x07, 0x7D, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xF0, 0xF4,
+    0x20, 0x40, 0x8D, 0x07, 0xD6, 0x06, 0x92, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xEE, 0xF3,
+    0x20, 0x40, 0xAA, 0x07, 0x9B, 0x06, 0xA7, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xF7, 0xF3,
+    0x20, 0x40, 0xBF, 0x07, 0x5D, 0x06, 0xBD, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x0A, 0xF4,
+    0x20, 0x40, 0xCC, 0x07, 0x1D, 0x06, 0xD2, 0x04, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x28, 0xF4,
+    0x20, 0x40, 0xD0, 0x07, 0xDC, 0x05, 0xE7, 0x04, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x51, 0xF3,
+    0x20, 0x40, 0xCC, 0x07, 0x9B, 0x05, 0xFD, 0x04, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x80, 0xF3,
+    0x20, 0x40, 0xBF, 0x07, 0x5B, 0x05, 0x12, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xB7, 0xF4,
+    0x20, 0x40, 0xAA, 0x07, 0x1D, 0x05, 0x27, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xF5, 0xF4,
+    0x20, 0x40, 0x8D, 0x07, 0xE2, 0x04, 0x3C, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x39, 0xF4,
+    0x20, 0x40, 0x69, 0x07, 0xAC, 0x04, 0x52, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x7D, 0xF4,
+    0x20, 0x40, 0x3E, 0x07, 0x7A, 0x04, 0x67, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xC5, 0xF4,
+    0x20, 0x40, 0x0C, 0x07, 0x4F, 0x04, 0x7C, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x0D, 0xF5,
+    0x20, 0x40, 0xD6, 0x06, 0x2B, 0x04, 0x92, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x52, 0xF4,
+    0x20, 0x40, 0x9B, 0x06, 0x0E, 0x04, 0xA7, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x95, 0xF4,
+    0x20, 0x40, 0x5D, 0x06, 0xF9, 0x03, 0xBC, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xD4, 0xF3,
+    0x20, 0x40, 0x1D, 0x06, 0xEC, 0x03, 0xD1, 0x05, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x0C, 0xF4,
+    0x20, 0x40, 0xDC, 0x05, 0xE8, 0x03, 0xE7, 0x05, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x3C, 0xF3,
+    0x20, 0x40, 0x9B, 0x05, 0xEC, 0x03, 0xFC, 0x05, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x64, 0xF3,
+    0x20, 0x40, 0x5B, 0x05, 0xF9, 0x03, 0x11, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x81, 0xF4,
+    0x20, 0x40, 0x1D, 0x05, 0x0E, 0x04, 0x26, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x94, 0xF5,
+    0x20, 0x40, 0xE2, 0x04, 0x2B, 0x04, 0x3C, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x9D, 0xF4,
+    0x20, 0x40, 0xAC, 0x04, 0x4F, 0x04, 0x51, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x9A, 0xF4,
+    0x20, 0x40, 0x7A, 0x04, 0x7A, 0x04, 0x66, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x8C, 0xF4,
+    0x20, 0x40, 0x4F, 0x04, 0xAC, 0x04, 0x7C, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x6F, 0xF4,
+    0x20, 0x40, 0x2B, 0x04, 0xE2, 0x04, 0x91, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x48, 0xF4,
+    0x20, 0x40, 0x0E, 0x04, 0x1D, 0x05, 0xA6, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x14, 0xF5,
+    0x20, 0x40, 0xF9, 0x03, 0x5B, 0x05, 0xBB, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xD7, 0xF3,
+    0x20, 0x40, 0xEC, 0x03, 0x9B, 0x05, 0xD1, 0x06, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07, 0xE8, 0x03,
+    0xD0, 0x07, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x8E, 0xF3,
+    0x20, 0x40, 0xE8, 0x03, 0xDC, 0x05, 0xE6, 0x06, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x3C, 0xF3,
+    0x20, 0x40, 0xEC, 0x03, 0x1D, 0x06, 0xFB, 0x06, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xE1, 0xF3,
+    0x20, 0x40, 0xF9, 0x03, 0x5D, 0x06, 0x11, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x7D, 0xF4,
+    0x20, 0x40, 0x0E, 0x04, 0x9B, 0x06, 0x26, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x14, 0xF5,
+    0x20, 0x40, 0x2B, 0x04, 0xD6, 0x06, 0x3B, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xA7, 0xF4,
+    0x20, 0x40, 0x4F, 0x04, 0x0C, 0x07, 0x50, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x37, 0xF5,
+    0x20, 0x40, 0x7A, 0x04, 0x3E, 0x07, 0x66, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xC4, 0xF4,
+    0x20, 0x40, 0xAC, 0x04, 0x69, 0x07, 0x7B, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x52, 0xF4,
+    0x20, 0x40, 0xE2, 0x04, 0x8D, 0x07, 0x90, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xE3, 0xF3,
+    0x20, 0x40, 0x1D, 0x05, 0xAA, 0x07, 0xA5, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x75, 0xF4,
+    0x20, 0x40, 0x5B, 0x05, 0xBF, 0x07, 0xBB, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0x0C, 0xF4,
+    0x20, 0x40, 0x9B, 0x05, 0xCC, 0x07, 0xD0, 0x07, 0xDC, 0x05, 0xD0, 0x07, 0xE8, 0x03, 0xD0, 0x07,
+    0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xAA, 0xF3,
+};
+
+// RMT items of 8 channel PPM frames, 300us low pulses, one frame per PPM_SAMPLE_ITEMS_PER_FRAME items
+#define PPM_SAMPLE_ITEMS_PER_FRAME 9
+static const uint32_t PPM_SAMPLE_ITEMS[] = {
+    0x84B0012C, 0x86A4012C, 0x82BC012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x8000012C, 0x84F1012C, 0x86A0012C, 0x82D1012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x8000012C, 0x8531012C, 0x8693012C, 0x82E7012C, 0x84B0012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x8000012C, 0x856F012C, 0x867E012C, 0x82FC012C, 0x84B0012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x85AA012C, 0x8661012C, 0x8311012C, 0x84B0012C,
+    0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x85E0012C, 0x863D012C, 0x8326012C,
+    0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x8612012C, 0x8612012C,
+    0x833C012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x863D012C,
+    0x85E0012C, 0x8351012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C,
+    0x8661012C, 0x85AA012C, 0x8366012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x8000012C, 0x867E012C, 0x856F012C, 0x837B012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x8000012C, 0x8693012C, 0x8531012C, 0x8391012C, 0x84B0012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x8000012C, 0x86A0012C, 0x84F1012C, 0x83A6012C, 0x84B0012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x86A4012C, 0x84B0012C, 0x83BB012C, 0x84B0012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x86A0012C, 0x846F012C, 0x83D1012C,
+    0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x8693012C, 0x842F012C,
+    0x83E6012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x867E012C,
+    0x83F1012C, 0x83FB012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C,
+    0x8661012C, 0x83B6012C, 0x8410012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x8000012C, 0x863D012C, 0x8380012C, 0x8426012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x8000012C, 0x8612012C, 0x834E012C, 0x843B012C, 0x84B0012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x8000012C, 0x85E0012C, 0x8323012C, 0x8450012C, 0x84B0012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x85AA012C, 0x82FF012C, 0x8466012C, 0x84B0012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x856F012C, 0x82E2012C, 0x847B012C,
+    0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x8531012C, 0x82CD012C,
+    0x8490012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x84F1012C,
+    0x82C0012C, 0x84A5012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C,
+    0x84B0012C, 0x82BC012C, 0x84BB012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x8000012C, 0x846F012C, 0x82C0012C, 0x84D0012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x8000012C, 0x842F012C, 0x82CD012C, 0x84E5012C, 0x84B0012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x8000012C, 0x83F1012C, 0x82E2012C, 0x84FA012C, 0x84B0012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x83B6012C, 0x82FF012C, 0x8510012C, 0x84B0012C,
+    0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x8380012C, 0x8323012C, 0x8525012C,
+    0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x834E012C, 0x834E012C,
+    0x853A012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x8323012C,
+    0x8380012C, 0x8550012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C,
+    0x82FF012C, 0x83B6012C, 0x8565012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x8000012C, 0x82E2012C, 0x83F1012C, 0x857A012C, 0x84B0012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x8000012C, 0x82CD012C, 0x842F012C, 0x858F012C, 0x84B0012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x8000012C, 0x82C0012C, 0x846F012C, 0x85A5012C, 0x84B0012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x8000012C, 0x82BC012C, 0x84B0012C, 0x85BA012C, 0x84B0012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x82C0012C, 0x84F1012C, 0x85CF012C,
+    0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x82CD012C, 0x8531012C,
+    0x85E5012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x82E2012C,
+    0x856F012C, 0x85FA012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C,
+    0x82FF012C, 0x85AA012C, 0x860F012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C,
+    0x8000012C, 0x8323012C, 0x85E0012C, 0x8624012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C,
+    0x82BC012C, 0x8000012C, 0x834E012C, 0x8612012C, 0x863A012C, 0x84B0012C, 0x86A4012C, 0x82BC012C,
+    0x86A4012C, 0x82BC012C, 0x8000012C, 0x8380012C, 0x863D012C, 0x864F012C, 0x84B0012C, 0x86A4012C,
+    0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x83B6012C, 0x8661012C, 0x8664012C, 0x84B0012C,
+    0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x83F1012C, 0x867E012C, 0x8679012C,
+    0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x842F012C, 0x8693012C,
+    0x868F012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C, 0x846F012C,
+    0x86A0012C, 0x86A4012C, 0x84B0012C, 0x86A4012C, 0x82BC012C, 0x86A4012C, 0x82BC012C, 0x8000012C,
+};
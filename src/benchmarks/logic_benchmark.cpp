@@ -0,0 +1,60 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "logic_engine.hpp"
+#include "logger.hpp"
+
+static const int LOGIC_BENCHMARK_TICKS = 1000;
+
+// Long expressions that touch every opcode, channels are filled in per logic channel
+static const char *const LOGIC_BENCHMARK_EXPRESSIONS[] = {
+    "ondelay(ch%d>1500&&delta(ch%d)<-5||failsafe,99)",
+    "offdelay(ch%d<1300&&ch%d<1600,500)||failsafe",
+    "ch%d>=1100&&ch%d<=1900&&ch1!=1500&&!(ch2==1000)",
+    "not failsafe and (ch%d > 1700 or ch%d < 1200)",
+};
+
+void runLogicBenchmark()
+{
+    static LogicEngine engine;
+    engine.clear();
+
+    char source[LOGIC_MAX_EXPRESSION + 16];
+    for (int i = 0; i < LOGIC_CHANNEL_COUNT; i++)
+    {
+        const char *format = LOGIC_BENCHMARK_EXPRESSIONS[i % (sizeof(LOGIC_BENCHMARK_EXPRESSIONS) / sizeof(LOGIC_BENCHMARK_EXPRESSIONS[0]))];
+        snprintf(source, sizeof(source), format, i % 9 + 1, (i + 4) % 9 + 1);
+        if (!engine.setExpression(FIRST_LOGIC_CHANNEL + i, source))
+        {
+            LOG.errorf("Benchmarks", "Logic benchmark expression '%s' does not compile", source);
+            return;
+        }
+    }
+
+    uint16_t channelValues[CHANNEL_COUNT] = {0};
+    ChannelMask changed;
+    uint32_t worstCycles = 0;
+    uint32_t totalCycles = 0;
+
+    for (int tick = 0; tick < LOGIC_BENCHMARK_TICKS; tick++)
+    {
+        // Sweep the inputs so comparisons, deltas and timers keep flipping
+        for (int i = 0; i < HIGHEST_CHANNEL_NUMBER; i++)
+        {
+            channelValues[i] = CHANNEL_MIN + (tick * 13 + i * 61) % (CHANNEL_MAX - CHANNEL_MIN + 1);
+        }
+
+        uint32_t startCycles = ESP.getCycleCount();
+        engine.evaluate(channelValues, (tick / 100) % 2, tick * 4, changed);
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+        totalCycles += cycles;
+        worstCycles = max(worstCycles, cycles);
+    }
+
+    LOG.infof("Benchmarks", "Logic %d expressions: %lu cycles/tick average, %lu worst (%luus at %d MHz)",
+              LOGIC_CHANNEL_COUNT, totalCycles / LOGIC_BENCHMARK_TICKS,
+              worstCycles, worstCycles / getCpuFrequencyMhz(), getCpuFrequencyMhz());
+}
+
+#endif
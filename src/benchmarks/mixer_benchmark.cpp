@@ -0,0 +1,48 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "mixer.hpp"
+#include "logger.hpp"
+
+static const int MIXER_BENCHMARK_TICKS = 1000;
+
+void runMixerBenchmark()
+{
+    // Worst case: every RC channel feeds every mixer channel
+    static Mixer mixer;
+    mixer.clear();
+    for (uint8_t output = FIRST_MIXER_CHANNEL; output <= LAST_MIXER_CHANNEL; output++)
+    {
+        for (uint8_t input = 1; input <= HIGHEST_CHANNEL_NUMBER; input++)
+        {
+            mixer.addTerm(input, output, (input * 7 + output) % 41 - 20);
+        }
+    }
+
+    uint16_t channelValues[CHANNEL_COUNT] = {0};
+    ChannelMask changed;
+    uint32_t worstCycles = 0;
+    uint32_t totalCycles = 0;
+
+    for (int tick = 0; tick < MIXER_BENCHMARK_TICKS; tick++)
+    {
+        // Move every input each tick so all outputs have to be recomputed
+        for (int i = 0; i < HIGHEST_CHANNEL_NUMBER; i++)
+        {
+            channelValues[i] = CHANNEL_MIN + (tick * 13 + i * 61) % (CHANNEL_MAX - CHANNEL_MIN + 1);
+        }
+
+        uint32_t startCycles = ESP.getCycleCount();
+        mixer.evaluate(channelValues, changed);
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+        totalCycles += cycles;
+        worstCycles = max(worstCycles, cycles);
+    }
+
+    LOG.infof("Benchmarks", "Mixer %dx%d (%d terms): %lu cycles/tick average, %lu worst (%luus at %d MHz)",
+              HIGHEST_CHANNEL_NUMBER, MIXER_CHANNEL_COUNT, mixer.getTermCount(), totalCycles / MIXER_BENCHMARK_TICKS,
+              worstCycles, worstCycles / getCpuFrequencyMhz(), getCpuFrequencyMhz());
+}
+
+#endif
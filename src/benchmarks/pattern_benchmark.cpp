@@ -0,0 +1,78 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "pattern_scheduler.hpp"
+#include "pin_map.hpp"
+#include "logger.hpp"
+
+static const int PATTERN_BENCHMARK_STEPS = 2000;
+
+static PatternConfig makePattern(std::initializer_list<PatternStep> steps)
+{
+    PatternConfig config;
+    for (const PatternStep &step : steps)
+    {
+        config.steps[config.numSteps++] = step;
+    }
+    return config;
+}
+
+void runPatternBenchmark()
+{
+    static LedcDriver ledc;
+    static PatternScheduler scheduler(ledc);
+    static PatternPool pool;
+
+    PatternConfig patterns[] = {
+        makePattern({{255, false, 30}, {0, false, 60}}),                                      // Strobe
+        makePattern({{255, false, 60}, {0, false, 80}, {255, false, 60}, {0, false, 500}}),   // Double flash
+        makePattern({{255, false, 50}, {0, false, 50}, {255, false, 50}, {0, false, 350}}),   // Police, one side
+        makePattern({{255, true, 120}, {0, true, 120}, {0, false, 480}}),                     // Knight rider, one lamp
+        makePattern({{255, true, 800}, {255, false, 200}, {0, true, 800}, {0, false, 200}})}; // Fade
+
+    const size_t patternCount = sizeof(patterns) / sizeof(patterns[0]);
+    PatternProgram *programs[patternCount];
+    for (size_t i = 0; i < patternCount; i++)
+    {
+        programs[i] = pool.acquire(patterns[i]);
+    }
+
+    // Every output runs a pattern, the knight rider ones chase each other in one group
+    uint32_t startMs = millis();
+    uint8_t outputCount = 0;
+    for (auto it = PIN_MAP.begin(); it != PIN_MAP.end(); ++it)
+    {
+        if (it->second.isPWM)
+        {
+            bool chaser = outputCount % patternCount == 3;
+            int8_t id = scheduler.add(it->second.pin, chaser ? 1 : 0, chaser ? outputCount * 60 : 0, true);
+            scheduler.setProgram(id, programs[outputCount % patternCount]);
+            outputCount++;
+        }
+    }
+
+    uint32_t worstCycles = 0;
+    uint32_t totalCycles = 0;
+    for (int step = 1; step <= PATTERN_BENCHMARK_STEPS; step++)
+    {
+        uint32_t startCycles = ESP.getCycleCount();
+        scheduler.advance(startMs + step * PATTERN_WHEEL_RESOLUTION_MS);
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+        totalCycles += cycles;
+        worstCycles = max(worstCycles, cycles);
+    }
+
+    for (int8_t id = 0; id < outputCount; id++)
+    {
+        scheduler.remove(id);
+    }
+
+    LOG.infof("Benchmarks", "Patterns on %d outputs: %lu cycles/step average, %lu worst (%luus at %d MHz)",
+              outputCount, totalCycles / PATTERN_BENCHMARK_STEPS, worstCycles, worstCycles / getCpuFrequencyMhz(),
+              getCpuFrequencyMhz());
+    LOG.infof("Benchmarks", "Patterns RAM: %d bytes per program, %d bytes pool, %d bytes scheduler",
+              sizeof(PatternProgram), sizeof(PatternPool), sizeof(PatternScheduler));
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "bordcomputer.hpp"
+#include "channel-handlers/thresholdPredicate.hpp"
+#include "logger.hpp"
+#include <functional>
+
+static const int THRESHOLD_BENCHMARK_PASSES = 100;
+
+// The previous std::function path, built the way ConfigManager used to build it
+static std::function<bool(uint16_t)> createThresholdFunction(const char *op, int threshold)
+{
+    if (strcmp(op, "lessThan") == 0)
+    {
+        return [threshold](uint16_t value)
+        { return value < threshold; };
+    }
+    return [threshold](uint16_t value)
+    { return value > threshold; };
+}
+
+void runThresholdBenchmark()
+{
+    std::function<bool(uint16_t)> function = createThresholdFunction("greaterThan", CHANNEL_MID);
+    ThresholdPredicate predicate(ThresholdOperator_GREATER_THAN, CHANNEL_MID, 0);
+
+    // volatile keeps the compiler from hoisting the calls out of the loops
+    volatile uint32_t functionHits = 0;
+    volatile uint32_t predicateHits = 0;
+
+    uint32_t startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < THRESHOLD_BENCHMARK_PASSES; pass++)
+    {
+        for (uint16_t value = CHANNEL_MIN; value <= CHANNEL_MAX; value++)
+        {
+            functionHits = functionHits + function(value);
+        }
+    }
+    uint32_t functionCycles = ESP.getCycleCount() - startCycles;
+
+    startCycles = ESP.getCycleCount();
+    for (int pass = 0; pass < THRESHOLD_BENCHMARK_PASSES; pass++)
+    {
+        for (uint16_t value = CHANNEL_MIN; value <= CHANNEL_MAX; value++)
+        {
+            predicateHits = predicateHits + predicate.evaluate(value);
+        }
+    }
+    uint32_t predicateCycles = ESP.getCycleCount() - startCycles;
+
+    const uint32_t evaluations = THRESHOLD_BENCHMARK_PASSES * (CHANNEL_MAX - CHANNEL_MIN + 1);
+    LOG.infof("Benchmarks", "Threshold std::function:     %lu cycles/100 evaluations", functionCycles * 100 / evaluations);
+    LOG.infof("Benchmarks", "Threshold compiled predicate: %lu cycles/100 evaluations", predicateCycles * 100 / evaluations);
+    LOG.infof("Benchmarks", "Threshold results %s (%lu hits)",
+              functionHits == predicateHits ? "match" : "DIFFER", predicateHits);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifdef BOARDCOMPUTER_BENCHMARKS
+
+#include "benchmarks.hpp"
+#include "channel-handlers/lightBarChannelHandler.hpp"
+#include "pin_map.hpp"
+#include "logger.hpp"
+
+static const int WS2812_BENCHMARK_PIXELS = 60;
+static const int WS2812_BENCHMARK_TICKS = 2 * UPDATE_LOOP_FREQUENCY_HZ;
+
+void runWs2812Benchmark()
+{
+    static Ws2812Driver driver;
+    static PatternPool pool;
+
+    // A single fade, each pixel 20ms behind the one before, runs as a chaser along the bar
+    PatternConfig fade;
+    fade.steps[fade.numSteps++] = {255, true, 300};
+    fade.steps[fade.numSteps++] = {0, true, 300};
+    fade.steps[fade.numSteps++] = {0, false, 600};
+    PatternProgram *programs[] = {pool.acquire(fade)};
+
+    LightBarChannelHandler handler(driver, PIN_MAP.at("AUX_1").pin, WS2812_BENCHMARK_PIXELS, 0xff4000, false,
+                                   programs, 1, 20, 0);
+    handler.attach();
+    handler.onChannelChange(CHANNEL_MAX);
+
+    // Tick like the control task, the frames are sent while it waits for the next tick
+    const uint32_t tickUs = 1000000 / UPDATE_LOOP_FREQUENCY_HZ;
+    uint32_t worstCycles = 0;
+    uint32_t totalCycles = 0;
+    uint32_t startUs = micros();
+    for (int tick = 0; tick < WS2812_BENCHMARK_TICKS; tick++)
+    {
+        uint32_t startCycles = ESP.getCycleCount();
+        handler.onTick(micros());
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+        totalCycles += cycles;
+        worstCycles = max(worstCycles, cycles);
+
+        int32_t remainingUs = startUs + (tick + 1) * tickUs - micros();
+        if (remainingUs > 0)
+        {
+            delayMicroseconds(remainingUs);
+        }
+    }
+    uint32_t elapsedMs = (micros() - startUs) / 1000;
+
+    // The handler holds the only strip, so it is the driver's first
+    uint32_t shown = driver.getFramesShown(0);
+    uint32_t busy = driver.getFramesBusy(0);
+    handler.detach();
+
+    LOG.infof("Benchmarks", "Light bar with %d pixels: %lu cycles/tick average, %lu worst (%luus of %luus tick at %d MHz)",
+              WS2812_BENCHMARK_PIXELS, totalCycles / WS2812_BENCHMARK_TICKS, worstCycles,
+              worstCycles / getCpuFrequencyMhz(), tickUs, getCpuFrequencyMhz());
+    LOG.infof("Benchmarks", "Light bar frames: %lu sent in %lums (%luHz), %lu found the strip busy",
+              shown, elapsedMs, elapsedMs > 0 ? shown * 1000 / elapsedMs : 0, busy);
+    LOG.infof("Benchmarks", "Light bar RAM: %d bytes driver, %d bytes handler",
+              sizeof(Ws2812Driver), sizeof(LightBarChannelHandler));
+}
+
+#endif
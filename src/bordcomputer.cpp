@@ -3,9 +3,23 @@
 #include <ArduinoJson.h>
 
 #include "logger.hpp"
-
-BoardComputer::BoardComputer(HardwareSerial *crsfSerial) : crsfSerial(crsfSerial), lastValidSignalTime(0), errorState(false)
+#include "task_model.hpp"
+
+BoardComputer::BoardComputer(HardwareSerial *crsfSerial) : outputShadow(ledcDriver), statusLed(ledcDriver), patternScheduler(ledcDriver),
+                                                           input(&crsf), inputProtocol(InputProtocol_CRSF), pendingInputProtocol(-1),
+                                                           crsfSerial(crsfSerial), baudNegotiator(crsfSerial, &crsf),
+                                                           telemetry(crsfSerial, &crsf), telemetryBatteryChannel(0), telemetryBatteryRatio(100),
+                                                           failsafeFrameGapMs(FAILSAFE_FRAME_GAP_MS), failsafeMinLinkQuality(0),
+                                                           errorState(false),
+                                                           taskHandle(NULL), pendingFrameSinceUs(0), framesCoalesced(0), alignOutputCommits(false), lastTickUs(0)
 {
+    activeHandlers = &handlerSets[0];
+    standbyHandlers = &handlerSets[1];
+    pendingHandlers = nullptr;
+    activeMixer = &mixers[0];
+    activeLogic = &logics[0];
+    mixerPending = false;
+
     if (!crsfSerial)
     {
         LOG.error("BoardComputer", "crsfSerial cannot be null");
@@ -15,43 +29,25 @@ BoardComputer::BoardComputer(HardwareSerial *crsfSerial) : crsfSerial(crsfSerial
         }
     }
 
-    this->status = BoardComputerStatus_UNCONFIGURED;
+    setStatus(BoardComputerStatus_UNCONFIGURED);
     memset(lastChannelValues, 0, sizeof(lastChannelValues));
-
-    // Initialize arrays with nullptr/default values
-    for (int i = 0; i < HIGHEST_CHANNEL_NUMBER; i++)
-    {
-        handlerCount[i] = 0;
-        for (int j = 0; j < MAX_HANDLERS_PER_CHANNEL; j++)
-        {
-            channelHandlers[i][j] = nullptr;
-            failSafeChannelValues[i][j] = -1;
-        }
-    }
+    memset(&inputStats, 0, sizeof(inputStats));
+    memset(&failsafeStats, 0, sizeof(failsafeStats));
+    memset(&dispatchStats, 0, sizeof(dispatchStats));
+    memset(&dispatchCounters, 0, sizeof(dispatchCounters));
+    memset(&pulseLatency, 0, sizeof(pulseLatency));
 }
 
 void BoardComputer::start()
 {
     LOG.info("BoardComputer", "Initializing board computer");
 
-    pinMode(STATUS_LED_PIN, OUTPUT);
-    digitalWrite(STATUS_LED_PIN, LOW);
-    LOG.debug("BoardComputer", "Status LED initialized");
-
-    // LED task - lowest priority
-    xTaskCreate(
-        [](void *pvParameters) -> void
-        { static_cast<BoardComputer *>(pvParameters)->statusLedTaskHandler(pvParameters); },
-        "statusLedTask",
-        4096,
-        this,
-        1, // Lowest priority
-        NULL);
-    LOG.debug("BoardComputer", "Status LED task created");
+    // Runs off a timer and the LEDC fade hardware, it only needs attention when a step ends
+    statusLed.begin(STATUS_LED_PIN);
 
     if (!crsfSerial)
     {
-        this->status = BoardComputerStatus_ERROR;
+        setStatus(BoardComputerStatus_ERROR);
         LOG.error("BoardComputer", "Invalid crsfSerial configuration - null pointer");
         while (true)
         {
@@ -59,22 +55,208 @@ void BoardComputer::start()
         }
     }
 
-    LOG.infof("BoardComputer", "Configuring CRSF serial on pins RX:%d, TX:%d", CRSF_RX_PIN, CRSF_TX_PIN);
-    crsfSerial->begin(CRSF_BAUDRATE, SERIAL_8N1, CRSF_RX_PIN, CRSF_TX_PIN);
-    LOG.debug("BoardComputer", "Serial configuration complete");
+    beginInput(inputProtocol);
 
-    crsf.begin(*crsfSerial);
-    LOG.debug("BoardComputer", "CRSF protocol initialized");
-
-    // Main task - higher priority
+    // Main task - highest tier of the task model
     xTaskCreate([](void *pvParameters) -> void
                 { static_cast<BoardComputer *>(pvParameters)->taskHandler(); },
-                "BoardComputer",
+                TASK_NAME_CONTROL,
                 8192,
                 this,
-                2, // Higher priority than LED task
-                NULL);
+                TASK_PRIORITY_CONTROL, // Above networking, outputs and the ADC sampler
+                &taskHandle);
     LOG.debug("BoardComputer", "Main board computer task created");
+
+    patternScheduler.start();
+    adcSampler.start();
+}
+
+void BoardComputer::beginInput(InputProtocol protocol)
+{
+    // Every protocol uses the receiver pin, release it from the previous one first
+    ppm.end();
+    crsfSerial->end();
+
+    LOG.infof("BoardComputer", "Reading %s from the receiver on pin %d", inputProtocolName(protocol), CRSF_RX_PIN);
+    switch (protocol)
+    {
+    case InputProtocol_SBUS:
+        // Inverted on the wire, the UART undoes it. SBUS receivers are never answered.
+        crsfSerial->begin(SBUS_BAUDRATE, SERIAL_8E2, CRSF_RX_PIN, -1, true);
+        sbus.begin(*crsfSerial, lastChannelValues);
+        input = &sbus;
+        inputStats.baudRate = SBUS_BAUDRATE;
+        break;
+
+    case InputProtocol_IBUS:
+        crsfSerial->begin(IBUS_BAUDRATE, SERIAL_8N1, CRSF_RX_PIN, -1);
+        ibus.begin(*crsfSerial, lastChannelValues);
+        input = &ibus;
+        inputStats.baudRate = IBUS_BAUDRATE;
+        break;
+
+    case InputProtocol_PPM:
+        // The capture task wakes us at the end of every frame, like the UART does for the others
+        if (!ppm.begin(CRSF_RX_PIN, lastChannelValues, [this]()
+                       { this->onInputReceive(); }))
+        {
+            setStatus(BoardComputerStatus_ERROR);
+        }
+        input = &ppm;
+        inputStats.baudRate = 0;
+        break;
+
+    default:
+        // Telemetry frames are queued in the driver, writing them never waits for the line
+        crsfSerial->setTxBufferSize(CRSF_TX_BUFFER_SIZE);
+        crsfSerial->begin(CRSF_BAUDRATE, SERIAL_8N1, CRSF_RX_PIN, CRSF_TX_PIN);
+        baudNegotiator.reset();
+        crsf.begin(*crsfSerial, lastChannelValues);
+        input = &crsf;
+        break;
+    }
+
+#if CRSF_EVENT_DRIVEN
+    if (protocol != InputProtocol_PPM)
+    {
+        // Only get called back once the line went idle, which is the end of a frame
+        crsfSerial->setRxTimeout(CRSF_RX_IDLE_SYMBOLS);
+        crsfSerial->onReceive([this]()
+                              { this->onInputReceive(); },
+                              true);
+    }
+#endif
+
+    inputProtocol = protocol;
+    inputStats.protocol = protocol;
+}
+
+void BoardComputer::setInputProtocol(InputProtocol protocol)
+{
+    if (taskHandle == NULL)
+    {
+        // Not started yet, start() sets up the protocol
+        inputProtocol = protocol;
+        inputStats.protocol = protocol;
+        return;
+    }
+
+    if (protocol == inputProtocol)
+    {
+        return;
+    }
+
+    // The control task owns the decoders, it switches over between two ticks
+    pendingInputProtocol = protocol;
+    xTaskNotifyGive(taskHandle);
+    while (pendingInputProtocol.load() >= 0)
+    {
+        vTaskDelay(1);
+    }
+}
+
+void BoardComputer::applyPendingInputProtocol()
+{
+    int protocol = pendingInputProtocol.load();
+    if (protocol < 0)
+    {
+        return;
+    }
+
+    beginInput((InputProtocol)protocol);
+    pendingInputProtocol = -1; // Acknowledge the switch
+}
+
+void BoardComputer::onInputReceive()
+{
+    // Runs in the UART event task or the PPM capture task. Keep the timestamp of the oldest undispatched
+    // frame so bursts are coalesced into one dispatch and the measured delay is the worst case.
+    uint32_t expected = 0;
+    uint32_t now = micros();
+    if (!pendingFrameSinceUs.compare_exchange_strong(expected, now == 0 ? 1 : now))
+    {
+        framesCoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (taskHandle != NULL)
+    {
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+void BoardComputer::waitForInput(TickType_t &lastWakeTime, TickType_t loopInterval)
+{
+#if CRSF_EVENT_DRIVEN
+    // Wake on the next frame, or after one loop interval so failsafe is still evaluated
+    ulTaskNotifyTake(pdTRUE, loopInterval);
+    lastWakeTime = xTaskGetTickCount();
+#else
+    // Wait until next interval, taking execution time into account
+    vTaskDelayUntil(&lastWakeTime, loopInterval);
+#endif
+}
+
+void BoardComputer::recordDispatch(uint32_t frameSince)
+{
+    if (frameSince == 0)
+    {
+        return;
+    }
+
+    uint32_t delayUs = micros() - frameSince;
+    InputDecoderStats decoderStats = input->getStats();
+    inputStats.crcErrors = decoderStats.crcErrors;
+    inputStats.decodeCycles = decoderStats.lastUpdateCycles;
+    inputStats.framesDispatched++;
+    inputStats.lastFrameToDispatchUs = delayUs;
+    if (delayUs > inputStats.maxFrameToDispatchUs)
+    {
+        inputStats.maxFrameToDispatchUs = delayUs;
+    }
+}
+
+TickType_t BoardComputer::commitOutputs(uint32_t frameSince, TickType_t loopInterval)
+{
+    // Everything the handlers set this tick goes out together
+    outputShadow.commitDigital(dispatchCounters.writes, dispatchCounters.writesSkipped);
+    if (!outputShadow.hasPendingDuties())
+    {
+        return loopInterval;
+    }
+
+    if (frameSince != 0)
+    {
+        if (pulseLatency.frames++ == 0)
+        {
+            pulseLatency.firstFrameUs = frameSince;
+        }
+        else
+        {
+            pulseLatency.frameOffsetUs += frameSince - pulseLatency.firstFrameUs;
+        }
+    }
+
+    uint32_t toPeriodEndUs = outputShadow.getMicrosToNextPeriod();
+    if (alignOutputCommits && toPeriodEndUs > OUTPUT_COMMIT_LEAD_US)
+    {
+        // Wake up just before the period ends, newer frames may still replace the pending duties
+        TickType_t untilCommit = pdMS_TO_TICKS((toPeriodEndUs - OUTPUT_COMMIT_LEAD_US) / 1000);
+        return constrain(untilCommit, (TickType_t)1, loopInterval);
+    }
+
+    outputShadow.commitDuties(dispatchCounters.writes, dispatchCounters.writesSkipped);
+
+    // Every waiting frame shows up in the period starting toPeriodEndUs from now
+    if (pulseLatency.frames > 0)
+    {
+        uint32_t firstLatencyUs = micros() + toPeriodEndUs - pulseLatency.firstFrameUs;
+        pulseLatency.latencySumUs += (uint64_t)firstLatencyUs * pulseLatency.frames - pulseLatency.frameOffsetUs;
+        pulseLatency.latencyFrames += pulseLatency.frames;
+        pulseLatency.maxUs = max(pulseLatency.maxUs, firstLatencyUs);
+        pulseLatency.frames = 0;
+        pulseLatency.frameOffsetUs = 0;
+    }
+    return loopInterval;
 }
 
 void BoardComputer::taskHandler()
@@ -84,32 +266,41 @@ void BoardComputer::taskHandler()
     unsigned long lastDebugTime = 0;
     const unsigned long DEBUG_INTERVAL = 1000; // Print debug info every second
 
-    LOG.info("BoardComputer", "Starting CRSF task handler");
-    LOG.infof("BoardComputer", "CRSF configured on Serial0 - RX: %d, TX: %d @ %d baud",
-              CRSF_RX_PIN, CRSF_TX_PIN, CRSF_BAUDRATE);
+    LOG.info("BoardComputer", "Starting control task handler");
 
     while (true)
     {
         unsigned long currentTime = millis();
+        uint32_t tickStartUs = micros();
 
-        // Update CRSF and immediately check link status
-        this->crsf.update();
-        if (crsf.isLinkUp())
-        {
-            lastValidSignalTime = currentTime; // Update timestamp when link is up
+        // A newly published handler set or input protocol goes live at the tick boundary
+        this->applyPendingHandlerSet();
+        this->applyPendingInputProtocol();
 
+        // Claim pending frames before reading, anything arriving later triggers the next pass
+        uint32_t frameSince = pendingFrameSinceUs.exchange(0);
+
+        // Decode the receiver and immediately check link status
+        this->input->update();
+        if (input == &crsf)
+        {
+            this->baudNegotiator.update(currentTime);
+            inputStats.baudRate = baudNegotiator.getBaudRate();
+        }
+        if (hasValidSignal(currentTime))
+        {
             if (this->status != BoardComputerStatus_CRSF_CONNECTED)
             {
-                LOG.info("BoardComputer", "CRSF link established");
-                this->status = BoardComputerStatus_CRSF_CONNECTED;
+                LOG.info("BoardComputer", "Receiver link established");
+                setStatus(BoardComputerStatus_CRSF_CONNECTED);
             }
         }
         else
         {
             if (this->status != BoardComputerStatus_CRSF_DISCONNECTED)
             {
-                LOG.info("BoardComputer", "CRSF link lost");
-                this->status = BoardComputerStatus_CRSF_DISCONNECTED;
+                LOG.info("BoardComputer", "Receiver link lost");
+                setStatus(BoardComputerStatus_CRSF_DISCONNECTED);
             }
         }
 
@@ -120,13 +311,40 @@ void BoardComputer::taskHandler()
         }
 
         this->executeChannelHandlers();
+        TickType_t waitTicks = this->commitOutputs(frameSince, pdMS_TO_TICKS(loopIntervalMs));
+        this->recordDispatch(frameSince);
+        if (input == &crsf)
+        {
+            this->sendTelemetry(currentTime);
+        }
+
+        uint32_t tickUs = micros() - tickStartUs;
+        dispatchCounters.maxTickUs = max(dispatchCounters.maxTickUs, tickUs);
+        if (tickUs > loopIntervalMs * 1000)
+        {
+            dispatchStats.tickOverruns++;
+        }
+
+        this->waitForInput(lastWakeTime, waitTicks);
+    }
+}
 
-        // Wait until next interval, taking execution time into account
-        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(loopIntervalMs));
+bool BoardComputer::beginHandlerSet(size_t count)
+{
+    standbyMixer().clear();
+    standbyLogic().clear();
+
+    if (!standbyHandlers->reset(count))
+    {
+        LOG.errorf("BoardComputer", "Too many handlers: %d (max %d)", count, MAX_CHANNEL_HANDLERS);
+        setStatus(BoardComputerStatus_ERROR);
+        return false;
     }
+    return true;
 }
 
-void BoardComputer::onChannelChange(uint8_t channel, IChannelHandler *handler, int failSafeChannelValue)
+bool BoardComputer::onChannelChange(uint8_t channel, IChannelHandler *handler, const FailsafeProfile &failsafe,
+                                    const ConditioningProfile &conditioning)
 {
     // Convert 1-based channel number to 0-based index
     uint8_t channelIndex = channel - 1;
@@ -134,185 +352,465 @@ void BoardComputer::onChannelChange(uint8_t channel, IChannelHandler *handler, i
     LOG.debugf("BoardComputer", "Registering handler for channel %d (index %d)",
                channel, channelIndex);
 
-    if (channelIndex >= HIGHEST_CHANNEL_NUMBER)
+    if (channelIndex >= CHANNEL_COUNT)
     {
         LOG.errorf("BoardComputer", "Channel %d exceeds maximum channel number", channel);
-        this->status = BoardComputerStatus_ERROR;
-        while (true)
-        {
-            delay(100); // Prevent watchdog reset while still halting execution
-        }
+        setStatus(BoardComputerStatus_ERROR);
+        return false;
     }
 
-    if (handlerCount[channelIndex] >= MAX_HANDLERS_PER_CHANNEL)
+    if (!standbyHandlers->add(channelIndex, handler, failsafe, conditioning))
     {
-        LOG.errorf("BoardComputer", "Maximum handlers reached for channel %d", channel);
-        this->status = BoardComputerStatus_ERROR;
-        while (true)
+        LOG.errorf("BoardComputer", "More handlers registered than reserved (%d)", standbyHandlers->size());
+        setStatus(BoardComputerStatus_ERROR);
+        return false;
+    }
+
+    return true;
+}
+
+bool BoardComputer::setMixer(const MixerConfig &config)
+{
+    Mixer &mixer = standbyMixer();
+    if (!mixer.load(config))
+    {
+        mixer.clear();
+        return false;
+    }
+
+    LOG.infof("BoardComputer", "Mixer with %d terms", mixer.getTermCount());
+    return true;
+}
+
+bool BoardComputer::setLogic(uint8_t channel, const char *expression)
+{
+    return standbyLogic().setExpression(channel, expression);
+}
+
+void BoardComputer::publishHandlerSet()
+{
+    HandlerTable *previous = activeHandlers;
+    pendingHandlers = standbyHandlers;
+
+    if (taskHandle == NULL)
+    {
+        // Control task not running yet, nobody else is looking at the handlers
+        applyPendingHandlerSet();
+    }
+    else
+    {
+        xTaskNotifyGive(taskHandle); // Don't wait for the next frame or timeout
+        while (pendingHandlers.load() != nullptr)
         {
-            delay(100); // Prevent watchdog reset while still halting execution
+            vTaskDelay(1);
         }
     }
 
-    channelHandlers[channelIndex][handlerCount[channelIndex]] = handler;
-    failSafeChannelValues[channelIndex][handlerCount[channelIndex]] = failSafeChannelValue;
-    handlerCount[channelIndex]++;
+    // The control task acknowledged the swap, nothing references the old set any more
+    previous->retire(activeHandlers, handlerArena);
+    standbyHandlers = previous;
+    LOG.infof("BoardComputer", "Handler set with %d handlers is live, %d LEDC channels on %d timers in use",
+              activeHandlers->size(), ledcDriver.getUsedChannels(), ledcDriver.getUsedTimers());
 }
 
-void BoardComputer::executeChannelHandlers()
+void BoardComputer::abortHandlerSet()
 {
-    unsigned long currentTime = millis();
-    bool hasValidSignal = crsf.isLinkUp() && ((currentTime - lastValidSignalTime) < SIGNAL_TIMEOUT_MS);
-
-    if (!hasValidSignal)
-    {
-        static unsigned long lastTimeoutLog = 0;
-        if (currentTime - lastTimeoutLog >= 5000)
-        { // Log timeout every second
-            LOG.warningf("BoardComputer", "Signal timeout - Last valid: %lums ago, Link: %s, Status: %d",
-                         currentTime - lastValidSignalTime,
-                         crsf.isLinkUp() ? "UP" : "DOWN",
-                         this->status);
-            lastTimeoutLog = currentTime;
-        }
+    standbyHandlers->retire(activeHandlers, handlerArena);
+}
+
+void BoardComputer::applyPendingHandlerSet()
+{
+    HandlerTable *next = pendingHandlers.load();
+    if (next == nullptr)
+    {
+        return;
     }
 
-    for (int channel = 0; channel < HIGHEST_CHANNEL_NUMBER; channel++)
+    HandlerTable *previous = activeHandlers;
+
+    // Release outputs that are not carried over first, new handlers may reuse their pins
+    for (size_t i = 0; i < previous->size(); i++)
     {
-        int currentValue;
+        if (next->indexOf(previous->handlers[i]) < 0)
+        {
+            previous->handlers[i]->detach();
+        }
+    }
 
-        if (hasValidSignal)
+    for (size_t i = 0; i < next->size(); i++)
+    {
+        int previousIndex = previous->indexOf(next->handlers[i]);
+        if (previousIndex >= 0)
         {
-            currentValue = crsf.getChannel(channel + 1);
-            if (currentValue < CHANNEL_MIN)
-            {
-                currentValue = CHANNEL_MIN;
-            }
-            else if (currentValue > CHANNEL_MAX)
+            // Carried over: keep its output and what it last received
+            next->outputs[i] = previous->outputs[previousIndex];
+            next->conditioners[i] = previous->conditioners[previousIndex];
+            if (previous->ticking & (1UL << previousIndex))
             {
-                currentValue = CHANNEL_MAX;
+                next->ticking |= 1UL << i;
             }
-            lastValidSignalTime = currentTime;
-            errorState = false;
         }
         else
         {
-            // Use failsafe values when no valid signal
-            for (int handlerIndex = 0; handlerIndex < handlerCount[channel]; handlerIndex++)
-            {
-                if (channelHandlers[channel][handlerIndex] == nullptr)
-                {
-                    continue;
-                }
-
-                int failsafeValue = failSafeChannelValues[channel][handlerIndex];
-                // If failsafe value is set (not -1), use it
-                if (failsafeValue != -1)
-                {
-                    channelHandlers[channel][handlerIndex]->onChannelChange(failsafeValue);
-                }
-                else
-                {
-                    // If no failsafe value set, use center position
-                    channelHandlers[channel][handlerIndex]->onChannelChange(CHANNEL_MID);
-                }
-            }
-            continue; // Skip the rest of the loop for this channel
+            next->handlers[i]->attach();
         }
+    }
 
-        // Only process value changes when we have a valid signal
-        if (currentValue == lastChannelValues[channel])
+    activeHandlers = next;
+    activeMixer = &mixers[next - handlerSets];
+    activeLogic = &logics[next - handlerSets];
+    mixerPending = true;
+    pendingChannels = next->getUsedChannels();
+    pendingHandlers = nullptr; // Acknowledge the swap
+}
+
+void BoardComputer::setFailsafeBudget(uint16_t frameGapMs, uint8_t minLinkQuality)
+{
+    LOG.infof("BoardComputer", "Failsafe after %dms without frames, minimum LQ %d%%", frameGapMs, minLinkQuality);
+    this->failsafeFrameGapMs = frameGapMs;
+    this->failsafeMinLinkQuality = minLinkQuality;
+}
+
+void BoardComputer::setTelemetry(const uint8_t ratesHz[CrsfTelemetryFrame_COUNT], uint8_t batteryChannel, uint16_t batteryRatio)
+{
+    uint8_t rates[CrsfTelemetryFrame_COUNT];
+    memcpy(rates, ratesHz, sizeof(rates));
+    if (batteryChannel < FIRST_SENSOR_CHANNEL || batteryChannel > CHANNEL_COUNT)
+    {
+        // Nothing measures the battery, don't report 0V
+        batteryChannel = 0;
+        rates[CrsfTelemetryFrame_BATTERY] = 0;
+    }
+
+    LOG.infof("BoardComputer", "Telemetry: battery %dHz (channel %d, ratio %d/100), flight mode %dHz, status %dHz",
+              rates[CrsfTelemetryFrame_BATTERY], batteryChannel, batteryRatio, rates[CrsfTelemetryFrame_FLIGHT_MODE],
+              rates[CrsfTelemetryFrame_STATUS]);
+    this->telemetryBatteryChannel = batteryChannel;
+    this->telemetryBatteryRatio = batteryRatio;
+    telemetry.setRates(rates);
+}
+
+void BoardComputer::sendTelemetry(unsigned long currentTime)
+{
+    switch (telemetry.takeDueFrame(currentTime))
+    {
+    case CrsfTelemetryFrame_BATTERY:
+    {
+        // Pin mV times the ratio in 1/100 is the battery voltage in 10µV, the frame wants 0.1V
+        uint32_t millivolts = adcSampler.getMillivolts(telemetryBatteryChannel - FIRST_SENSOR_CHANNEL);
+        telemetry.sendBattery(millivolts * telemetryBatteryRatio / 10000);
+        break;
+    }
+
+    case CrsfTelemetryFrame_FLIGHT_MODE:
+        telemetry.sendFlightMode(getFlightMode());
+        break;
+
+    case CrsfTelemetryFrame_STATUS:
+    {
+        CrsfBoardStatus boardStatus;
+        boardStatus.status = status;
+        boardStatus.failsafeStage = failsafeStats.stage;
+        boardStatus.maxTickUs = min(dispatchStats.maxTickUs, (uint32_t)UINT16_MAX);
+        boardStatus.tickOverruns = dispatchStats.tickOverruns;
+        for (uint8_t i = 0; i < CRSF_TELEMETRY_STATUS_SENSORS; i++)
         {
-            continue;
+            boardStatus.sensorMillivolts[i] = i < SENSOR_CHANNEL_COUNT ? adcSampler.getMillivolts(i) : 0;
         }
+        telemetry.sendBoardStatus(boardStatus);
+        break;
+    }
 
-        for (int handlerIndex = 0; handlerIndex < handlerCount[channel]; handlerIndex++)
-        {
-            if (channelHandlers[channel][handlerIndex] == nullptr)
-            {
-                continue;
-            }
+    default:
+        break;
+    }
+}
+
+const char *BoardComputer::getFlightMode() const
+{
+    switch (status)
+    {
+    case BoardComputerStatus_UNCONFIGURED:
+        return "NO CONFIG";
+    case BoardComputerStatus_ERROR:
+        return "ERROR";
+    default:
+        break;
+    }
 
-            channelHandlers[channel][handlerIndex]->onChannelChange(currentValue);
+    switch (failsafeStats.stage)
+    {
+    case FailsafeStage_HOLD:
+        return "FS HOLD";
+    case FailsafeStage_RAMP:
+        return "FS RAMP";
+    case FailsafeStage_SETTLED:
+        return "FAILSAFE";
+    default:
+        return "OK";
+    }
+}
+
+bool BoardComputer::hasValidSignal(unsigned long currentTime) const
+{
+    unsigned long lastFrameTime = input->getLastChannelsTime();
+    // Frames may have been decoded after currentTime was taken, hence the signed difference
+    if (lastFrameTime == 0 || (long)(currentTime - lastFrameTime) >= (long)failsafeFrameGapMs)
+    {
+        return false;
+    }
+
+    CrsfLinkStatistics linkStatistics;
+    if (failsafeMinLinkQuality > 0 && input->getLinkStatistics(linkStatistics) &&
+        linkStatistics.uplinkLinkQuality < failsafeMinLinkQuality)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void BoardComputer::updateFailsafeStage(bool validSignal, unsigned long currentTime)
+{
+    if (validSignal)
+    {
+        if (failsafeStats.stage != FailsafeStage_NONE)
+        {
+            failsafeStats.stage = FailsafeStage_NONE;
+            failsafeStats.recoveredAt = currentTime;
+            LOG.infof("BoardComputer", "Failsafe ended after %lums", currentTime - failsafeStats.enteredAt);
         }
+        return;
+    }
 
-        lastChannelValues[channel] = currentValue;
+    if (failsafeStats.stage == FailsafeStage_NONE)
+    {
+        failsafeStats.stage = FailsafeStage_HOLD;
+        failsafeStats.lastFrameAt = input->getLastChannelsTime();
+        failsafeStats.enteredAt = currentTime;
+        failsafeStats.rampAt = 0;
+        failsafeStats.settledAt = 0;
+        failsafeStats.recoveredAt = 0;
+        LOG.warningf("BoardComputer", "Failsafe - last frame %lums ago", currentTime - failsafeStats.lastFrameAt);
     }
 }
 
-void BoardComputer::statusLedTaskHandler(void *pvParameters)
+FailsafeStage BoardComputer::stagedFailsafeValue(const FailsafeProfile &profile, uint16_t lastValue,
+                                                 unsigned long elapsedMs, uint16_t &value)
 {
-    BoardComputer *boardComputer = static_cast<BoardComputer *>(pvParameters);
+    uint16_t target = profile.value != -1 ? profile.value : CHANNEL_MID;
 
-    bool bootingBlinkState = false;
-    int brightness = 0;
-    bool isBreathingUp = true;
+    // Nothing was ever received, there is no value to hold
+    if (lastValue == 0)
+    {
+        value = target;
+        return FailsafeStage_SETTLED;
+    }
 
-    while (true)
+    if (elapsedMs < profile.holdMs)
+    {
+        value = lastValue;
+        return FailsafeStage_HOLD;
+    }
+
+    uint32_t distance = abs((int)target - (int)lastValue);
+    uint32_t travelled = (uint32_t)profile.rampRate * (elapsedMs - profile.holdMs) / 1000;
+    if (profile.rampRate == 0 || travelled >= distance)
+    {
+        value = target;
+        return FailsafeStage_SETTLED;
+    }
+
+    value = lastValue < target ? lastValue + travelled : lastValue - travelled;
+    return FailsafeStage_RAMP;
+}
+
+void BoardComputer::executeChannelHandlers()
+{
+    unsigned long currentTime = millis();
+    bool validSignal = hasValidSignal(currentTime);
+    bool wasInFailsafe = failsafeStats.stage != FailsafeStage_NONE;
+    updateFailsafeStage(validSignal, currentTime);
+
+    HandlerTable &handlers = *activeHandlers;
+    const size_t handlerCount = handlers.size();
+    bool inFailsafe = failsafeStats.stage != FailsafeStage_NONE;
+    if (inFailsafe != wasInFailsafe)
+    {
+        // Every handler gets a tick to react to the edge
+        for (size_t i = 0; i < handlerCount; i++)
+        {
+            handlers.handlers[i]->onFailsafe(inFailsafe);
+        }
+        handlers.ticking = handlerCount < 32 ? (1UL << handlerCount) - 1 : UINT32_MAX;
+    }
+
+    if (validSignal)
     {
-        switch (boardComputer->status)
+        errorState = false;
+    }
+
+    // Channels whose handlers need to be looked at this tick. The decoder unpacks
+    // straight into lastChannelValues and tells us what changed, on a failsafe edge
+    // every channel is a candidate and while ramping failsafe values keep moving.
+    ChannelMask candidateChannels = ChannelMask::fromBits(input->takeChangedChannels());
+    candidateChannels |= pendingChannels;
+    pendingChannels.clear();
+
+    // Only picks up what the sampler task filtered last, the ADC is never waited for
+    adcSampler.publish(lastChannelValues, candidateChannels);
+
+    // Mixer channels follow their inputs, once anything was received
+    if (input->getLastChannelsTime() != 0 && (mixerPending || candidateChannels.intersects(activeMixer->getInputs())))
+    {
+        activeMixer->evaluate(lastChannelValues, candidateChannels);
+        mixerPending = false;
+    }
+
+    // Logic channels see the mixed values and the failsafe state, so they also run without a signal
+    if (!activeLogic->isEmpty())
+    {
+        activeLogic->evaluate(lastChannelValues, !validSignal, currentTime, candidateChannels);
+    }
+
+    if (!validSignal || wasInFailsafe)
+    {
+        candidateChannels = activeHandlers->getUsedChannels();
+    }
+
+    // While in failsafe lastChannelValues keeps the last received values, which is what outputs hold
+    unsigned long failsafeElapsed = currentTime - failsafeStats.enteredAt;
+    FailsafeStage leastAdvancedStage = FailsafeStage_SETTLED;
+    FailsafeStage mostAdvancedStage = FailsafeStage_HOLD;
+
+    // Conditioning runs on tick time and spreads new values over the frame interval
+    uint32_t nowUs = micros();
+    uint32_t tickUs = nowUs - lastTickUs;
+    lastTickUs = nowUs;
+    uint32_t frameIntervalUs = constrain(input->getStats().lastFrameGapUs, (uint32_t)1000, (uint32_t)CONDITIONER_MAX_INTERVAL_US);
+
+    // One sweep over the channel-sorted table
+    for (size_t i = 0; i < handlerCount; i++)
+    {
+        uint8_t channel = handlers.channels[i];
+        uint32_t entryBit = 1UL << i;
+        bool ticking = handlers.ticking & entryBit;
+        if (!candidateChannels.test(channel) && !handlers.conditioners[i].settling && !ticking)
+        {
+            continue;
+        }
+
+        uint16_t value = lastChannelValues[channel];
+        FailsafeStage stage = FailsafeStage_NONE;
+        // Logic channels react to failsafe in their expression instead, sensors keep measuring
+        if (!validSignal && channel < FIRST_LOGIC_CHANNEL - 1)
+        {
+            stage = stagedFailsafeValue(handlers.failsafes[i], lastChannelValues[channel],
+                                        failsafeElapsed, value);
+            leastAdvancedStage = min(leastAdvancedStage, stage);
+            mostAdvancedStage = max(mostAdvancedStage, stage);
+        }
+
+        if (handlers.conditioning[i].enabled())
         {
-        case BoardComputerStatus_UNCONFIGURED:
-            // blink the led slowly
-            analogWrite(STATUS_LED_PIN, bootingBlinkState ? 255 : 0);
-            bootingBlinkState = !bootingBlinkState;
-            vTaskDelay(pdMS_TO_TICKS(500));
-            break;
-
-        case BoardComputerStatus_CRSF_CONNECTED:
-            // breath the led slowly
-            analogWrite(STATUS_LED_PIN, brightness);
-            brightness = (brightness + (isBreathingUp ? 1 : -1));
-            if (brightness > 255)
+            if (stage == FailsafeStage_SETTLED)
             {
-                brightness = 255;
-                isBreathingUp = false;
+                // Failsafe wants the output at its value now, no smoothing
+                handlers.conditioners[i].reset(value);
             }
-            else if (brightness < 0)
+            else
             {
-                brightness = 0;
-                isBreathingUp = true;
+                value = handlers.conditioners[i].update(handlers.conditioning[i], value, nowUs, tickUs, frameIntervalUs);
             }
-            analogWrite(STATUS_LED_PIN, brightness);
-            vTaskDelay(pdMS_TO_TICKS(10));
-            break;
-
-        case BoardComputerStatus_CRSF_DISCONNECTED:
-            // blink rapidly
-            analogWrite(STATUS_LED_PIN, 255);
-            vTaskDelay(pdMS_TO_TICKS(150));
-            analogWrite(STATUS_LED_PIN, 0);
-            vTaskDelay(pdMS_TO_TICKS(150));
-            break;
-
-        case BoardComputerStatus_ERROR:
-            // double blink rapidly then pause for half a second
-
-            // first blink
-            analogWrite(STATUS_LED_PIN, 255);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            analogWrite(STATUS_LED_PIN, 0);
-            vTaskDelay(pdMS_TO_TICKS(100));
-
-            // second blink
-            analogWrite(STATUS_LED_PIN, 255);
-            vTaskDelay(pdMS_TO_TICKS(100));
-            analogWrite(STATUS_LED_PIN, 0);
-
-            // pause
-            vTaskDelay(pdMS_TO_TICKS(500));
-            break;
-
-        default:
-            LOG.warningf("BoardComputer", "unknown status reached: %d", boardComputer->status);
-            break;
         }
+
+        // Only real transitions reach the handler
+        if (value != handlers.outputs[i])
+        {
+            handlers.handlers[i]->onChannelChange(value);
+            handlers.outputs[i] = value;
+            dispatchCounters.calls++;
+        }
+        else if (!ticking)
+        {
+            dispatchCounters.skipped++;
+            continue;
+        }
+
+        // Handlers that move on their own keep being ticked until they settle
+        if (handlers.handlers[i]->onTick(nowUs))
+        {
+            handlers.ticking |= entryBit;
+        }
+        else
+        {
+            handlers.ticking &= ~entryBit;
+        }
+    }
+
+    if (!validSignal)
+    {
+        if (mostAdvancedStage > FailsafeStage_HOLD && failsafeStats.rampAt == 0)
+        {
+            failsafeStats.rampAt = currentTime;
+        }
+        if (leastAdvancedStage == FailsafeStage_SETTLED && failsafeStats.settledAt == 0)
+        {
+            failsafeStats.settledAt = currentTime;
+            LOG.infof("BoardComputer", "Failsafe settled after %lums", currentTime - failsafeStats.enteredAt);
+        }
+        failsafeStats.stage = mostAdvancedStage;
+    }
+
+    if (currentTime - dispatchCounters.windowStart >= 1000)
+    {
+        dispatchStats.callsPerSecond = dispatchCounters.calls * 1000 / (currentTime - dispatchCounters.windowStart);
+        dispatchStats.callsSavedPerSecond = dispatchCounters.skipped * 1000 / (currentTime - dispatchCounters.windowStart);
+        dispatchStats.totalCalls += dispatchCounters.calls;
+        dispatchStats.totalSaved += dispatchCounters.skipped;
+        dispatchStats.writesPerSecond = dispatchCounters.writes * 1000 / (currentTime - dispatchCounters.windowStart);
+        dispatchStats.writesSkippedPerSecond = dispatchCounters.writesSkipped * 1000 / (currentTime - dispatchCounters.windowStart);
+        dispatchStats.totalWrites += dispatchCounters.writes;
+        dispatchStats.totalWritesSkipped += dispatchCounters.writesSkipped;
+        dispatchStats.maxTickUs = dispatchCounters.maxTickUs;
+        dispatchCounters.calls = 0;
+        dispatchCounters.skipped = 0;
+        dispatchCounters.writes = 0;
+        dispatchCounters.writesSkipped = 0;
+        dispatchCounters.maxTickUs = 0;
+
+        inputStats.meanFrameToPulseUs = pulseLatency.latencyFrames > 0 ? pulseLatency.latencySumUs / pulseLatency.latencyFrames : 0;
+        inputStats.maxFrameToPulseUs = pulseLatency.maxUs;
+        pulseLatency.latencySumUs = 0;
+        pulseLatency.latencyFrames = 0;
+        pulseLatency.maxUs = 0;
+        dispatchCounters.windowStart = currentTime;
+    }
+}
+
+void BoardComputer::setStatus(BoardComputerStatus newStatus)
+{
+    status = newStatus;
+    switch (newStatus)
+    {
+    case BoardComputerStatus_UNCONFIGURED:
+        statusLed.show(StatusLedPattern_SLOW_BLINK);
+        break;
+    case BoardComputerStatus_CRSF_CONNECTED:
+        statusLed.show(StatusLedPattern_BREATHE);
+        break;
+    case BoardComputerStatus_CRSF_DISCONNECTED:
+        statusLed.show(StatusLedPattern_FAST_BLINK);
+        break;
+    default:
+        statusLed.show(StatusLedPattern_DOUBLE_BLINK);
+        break;
     }
 }
 
 bool BoardComputer::isReceiving() const
 {
-    return crsf.isLinkUp() && ((millis() - lastValidSignalTime) < SIGNAL_TIMEOUT_MS);
+    return hasValidSignal(millis());
 }
 
 bool BoardComputer::hasError() const
@@ -320,9 +818,20 @@ bool BoardComputer::hasError() const
     return status == BoardComputerStatus_ERROR || !isReceiving() || status == BoardComputerStatus_UNCONFIGURED;
 }
 
+LinkStats BoardComputer::getLinkStats() const
+{
+    LinkStats linkStats;
+    linkStats.valid = input->getLinkStatistics(linkStats.statistics);
+    InputDecoderStats decoderStats = input->getStats();
+    linkStats.lastFrameGapUs = decoderStats.lastFrameGapUs;
+    linkStats.maxFrameGapUs = decoderStats.maxFrameGapUs;
+    linkStats.telemetry = telemetry.getStats();
+    return linkStats;
+}
+
 String BoardComputer::getPinMap()
 {
-    StaticJsonDocument<512> doc;
+    StaticJsonDocument<1024> doc;
 
     const auto &pinMap = ::getPinMap(); // Use global scope operator to get the function from pin_map.hpp
 
@@ -335,26 +844,10 @@ String BoardComputer::getPinMap()
         JsonObject pinObj = doc.createNestedObject(name);
         pinObj["pin"] = info.pin;
         pinObj["isPWM"] = info.isPWM;
+        pinObj["isADC"] = info.isADC;
     }
 
     String output;
     serializeJson(doc, output);
     return output;
 }
-
-void BoardComputer::cleanup()
-{
-    for (uint8_t channel = 0; channel < HIGHEST_CHANNEL_NUMBER; channel++)
-    {
-        for (uint8_t i = 0; i < handlerCount[channel]; i++)
-        {
-            if (channelHandlers[channel][i])
-            {
-                delete channelHandlers[channel][i];
-                channelHandlers[channel][i] = nullptr;
-                failSafeChannelValues[channel][i] = -1;
-            }
-        }
-        handlerCount[channel] = 0;
-    }
-}
@@ -1,16 +1,26 @@
 #pragma once
 
 #include <Arduino.h>
-#include <ESP32Servo.h>
-#include <AlfredoCRSF.h>
 #include <functional>
+#include <atomic>
 
 #include "const.hpp"
-#define HIGHEST_CHANNEL_NUMBER 16
-#define MAX_HANDLERS_PER_CHANNEL 10 // Maximum number of handlers per channel
-#define CHANNEL_MIN 1000
-#define CHANNEL_MAX 2000
-#define CHANNEL_MID CHANNEL_MIN + ((CHANNEL_MAX - CHANNEL_MIN) / 2)
+#include "crsf/crsf_decoder.hpp"
+#include "crsf/crsf_baud_negotiator.hpp"
+#include "crsf/crsf_telemetry.hpp"
+#include "inputs/sbus_decoder.hpp"
+#include "inputs/ibus_decoder.hpp"
+#include "inputs/ppm_decoder.hpp"
+#include "channels.hpp"
+#include "handler_table.hpp"
+#include "mixer.hpp"
+#include "logic_engine.hpp"
+#include "pattern_scheduler.hpp"
+#include "outputs/ledc_driver.hpp"
+#include "outputs/output_shadow.hpp"
+#include "outputs/ws2812_driver.hpp"
+#include "outputs/status_led.hpp"
+#include "inputs/adc_sampler.hpp"
 
 enum BoardComputerStatus
 {
@@ -20,11 +30,91 @@ enum BoardComputerStatus
     BoardComputerStatus_ERROR
 };
 
+struct InputStats
+{
+    InputProtocol protocol;
+    uint32_t framesDispatched;      // Dispatch passes triggered by at least one received frame
+    uint32_t framesCoalesced;       // Frames that arrived while a dispatch was already pending
+    uint32_t lastFrameToDispatchUs; // Delay between frame completion and handler dispatch
+    uint32_t maxFrameToDispatchUs;
+    uint32_t crcErrors;
+    uint32_t decodeCycles; // CPU cycles of the last decode pass
+    uint32_t baudRate;     // Current (negotiated) baud rate, 0 for PPM
+    uint32_t meanFrameToPulseUs; // Frame completion to the start of the first PWM period carrying it, over the last second
+    uint32_t maxFrameToPulseUs;
+};
+
+enum FailsafeStage
+{
+    FailsafeStage_NONE,    // Valid signal, outputs follow their channel
+    FailsafeStage_HOLD,    // Output keeps the last received value
+    FailsafeStage_RAMP,    // Output moves towards its failsafe value
+    FailsafeStage_SETTLED  // Output sits at its failsafe value
+};
+
+/**
+ * @brief millis() timestamps of the last failsafe's stage transitions, 0 if not reached
+ */
+struct FailsafeStats
+{
+    FailsafeStage stage;        // Most advanced stage any output is in
+    unsigned long lastFrameAt;  // Last RC frame before the failsafe
+    unsigned long enteredAt;    // Failsafe detected, outputs hold
+    unsigned long rampAt;       // First output left its hold stage
+    unsigned long settledAt;    // All outputs reached their failsafe value
+    unsigned long recoveredAt;  // Valid signal again
+};
+
+struct LinkStats
+{
+    bool valid; // A LINK_STATISTICS frame arrived recently
+    CrsfLinkStatistics statistics;
+    uint32_t lastFrameGapUs;
+    uint32_t maxFrameGapUs;
+    CrsfTelemetryStats telemetry;
+};
+
+struct DispatchStats
+{
+    uint32_t callsPerSecond;      // Handler invocations
+    uint32_t callsSavedPerSecond; // Candidate invocations skipped because the value did not change
+    uint32_t totalCalls;
+    uint32_t totalSaved;
+    uint32_t writesPerSecond;        // Outputs changed by the end of tick commit
+    uint32_t writesSkippedPerSecond; // Outputs set to the level or duty they already had
+    uint32_t totalWrites;
+    uint32_t totalWritesSkipped;
+    uint32_t maxTickUs;    // Longest control tick in the last second
+    uint32_t tickOverruns; // Ticks that took longer than the loop interval
+};
+
 class IChannelHandler
 {
 public:
     virtual ~IChannelHandler() = default;
+
+    /**
+     * @brief Claim and initialise the output, called by the control task when the handler goes live
+     */
+    virtual void attach() {}
+
+    /**
+     * @brief Release the output, called by the control task before the handler is retired
+     */
+    virtual void detach() {}
+
     virtual void onChannelChange(uint16_t value) = 0;
+
+    /**
+     * @brief Advance an output that moves on its own, called every tick after onChannelChange() until it returns false
+     * @return true to be called again on the next tick
+     */
+    virtual bool onTick(uint32_t nowUs) { return false; }
+
+    /**
+     * @brief Signal loss started or ended, called on both edges before the tick's dispatch
+     */
+    virtual void onFailsafe(bool active) {}
 };
 
 class BoardComputer
@@ -32,7 +122,106 @@ class BoardComputer
 public:
     BoardComputer(HardwareSerial *crsfSerial);
     void start();
-    void onChannelChange(uint8_t channel, IChannelHandler *handler, int failSafeChannelValue = -1);
+    /**
+     * @brief Start building a new handler set next to the running one
+     * @param count Number of handlers that will be registered
+     */
+    bool beginHandlerSet(size_t count);
+
+    /**
+     * @brief Register a handler for a channel in the set being built
+     * Handlers that are already part of the running set are carried over untouched.
+     * @param channel 1-based channel number, RC, mixer or logic channel
+     * @param conditioning Smoothing applied to the values the handler receives
+     * @return false if the channel is invalid or more handlers than reserved were registered
+     */
+    bool onChannelChange(uint8_t channel, IChannelHandler *handler, const FailsafeProfile &failsafe,
+                         const ConditioningProfile &conditioning = ConditioningProfile());
+
+    /**
+     * @brief Set the mixer that goes live together with the set being built
+     * @return false if the mixer config is invalid
+     */
+    bool setMixer(const MixerConfig &config);
+
+    /**
+     * @brief Set the expression of a logic channel that goes live together with the set being built
+     * @param channel 1-based logic channel, FIRST_LOGIC_CHANNEL..LAST_LOGIC_CHANNEL
+     * @return false if the expression does not compile
+     */
+    bool setLogic(uint8_t channel, const char *expression);
+
+    /**
+     * @brief Arena handlers for beginHandlerSet() have to be constructed in
+     */
+    HandlerArena &getHandlerArena() { return handlerArena; }
+
+    /**
+     * @brief LEDC channels and timers PWM outputs are attached to
+     */
+    LedcDriver &getLedcDriver() { return ledcDriver; }
+
+    /**
+     * @brief RMT channels WS2812 light bars are attached to
+     */
+    Ws2812Driver &getWs2812Driver() { return ws2812Driver; }
+
+    /**
+     * @brief Analog inputs published on the sensor channels
+     */
+    AdcSampler &getAdcSampler() { return adcSampler; }
+
+    /**
+     * @brief Output state handlers write during a tick, committed to the pins when the tick ends
+     */
+    OutputShadow &getOutputShadow() { return outputShadow; }
+
+    /**
+     * @brief Shared timebase blink and sequence handlers register their outputs with
+     */
+    PatternScheduler &getPatternScheduler() { return patternScheduler; }
+
+    /**
+     * @brief Swap the set being built in at the next tick boundary
+     * Blocks until the control task switched over, then destroys the handlers
+     * of the previous set that were not carried over.
+     */
+    void publishHandlerSet();
+
+    /**
+     * @brief Throw away the set being built, destroying handlers that are not running
+     */
+    void abortHandlerSet();
+
+    /**
+     * @brief Configure when signal loss is detected
+     * @param frameGapMs Maximum time without RC frames before failsafe starts
+     * @param minLinkQuality Uplink LQ (%) below which failsafe starts, 0 to ignore link statistics
+     */
+    void setFailsafeBudget(uint16_t frameGapMs, uint8_t minLinkQuality);
+
+    /**
+     * @brief Hold PWM duties back until just before their timer's next period instead of committing every tick
+     * Frames that arrive until OUTPUT_COMMIT_LEAD_US before a period ends still make it into that period.
+     */
+    void setOutputCommitAlignment(bool aligned) { alignOutputCommits = aligned; }
+
+    /**
+     * @brief Select how the receiver is read, all protocols use the receiver pin
+     * Before start() this only picks the protocol start() sets up, afterwards it
+     * blocks until the control task switched over at the next tick boundary.
+     */
+    void setInputProtocol(InputProtocol protocol);
+
+    InputProtocol getInputProtocol() const { return inputProtocol; }
+
+    /**
+     * @brief Configure the telemetry sent back to the radio
+     * @param ratesHz Frames per second per CrsfTelemetryFrame, 0 to disable one
+     * @param batteryChannel Sensor channel carrying the battery voltage, 0 if there is none
+     * @param batteryRatio Battery voltage per sensor pin voltage, in 1/100
+     */
+    void setTelemetry(const uint8_t ratesHz[CrsfTelemetryFrame_COUNT], uint8_t batteryChannel, uint16_t batteryRatio);
 
     /**
      * @brief Check if the board computer is receiving valid signals
@@ -48,15 +237,9 @@ public:
 
     String getPinMap();
 
-    /**
-     * @brief Cleans up all handlers for all channels
-     * Deletes handler instances and clears the arrays
-     */
-    void cleanup();
-
     int getChannelValue(uint8_t channel) const
     {
-        if (channel >= HIGHEST_CHANNEL_NUMBER)
+        if (channel >= CHANNEL_COUNT)
             return CHANNEL_MID;
         // CRSF uses 1-based channels, so add 1 to our 0-based index
         return lastChannelValues[channel];
@@ -64,21 +247,114 @@ public:
 
     BoardComputerStatus getStatus() const { return status; }
 
+    InputStats getInputStats() const
+    {
+        InputStats stats = inputStats;
+        stats.framesCoalesced = framesCoalesced.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    FailsafeStats getFailsafeStats() const { return failsafeStats; }
+
+    LinkStats getLinkStats() const;
+
+    DispatchStats getDispatchStats() const { return dispatchStats; }
+
 private:
     void taskHandler();
-    IChannelHandler *channelHandlers[HIGHEST_CHANNEL_NUMBER][MAX_HANDLERS_PER_CHANNEL];
-    int failSafeChannelValues[HIGHEST_CHANNEL_NUMBER][MAX_HANDLERS_PER_CHANNEL];
-    uint8_t handlerCount[HIGHEST_CHANNEL_NUMBER]; // Tracks number of handlers for each channel
-    uint16_t lastChannelValues[HIGHEST_CHANNEL_NUMBER];
-    AlfredoCRSF crsf;
-    HardwareSerial *crsfSerial;
+    uint16_t lastChannelValues[CHANNEL_COUNT]; // RC channels followed by mixer, logic and sensor channels
+
+    // Double buffered handler sets, only the control task touches the active one.
+    // Each handler set has the mixer and logic engine at the same index that go live with it.
+    HandlerArena handlerArena;
+    LedcDriver ledcDriver;
+    OutputShadow outputShadow;
+    StatusLed statusLed;
+    Ws2812Driver ws2812Driver;
+    AdcSampler adcSampler;
+    PatternScheduler patternScheduler;
+    HandlerTable handlerSets[2];
+    Mixer mixers[2];
+    LogicEngine logics[2];
+    HandlerTable *activeHandlers;
+    HandlerTable *standbyHandlers;                   // Set being built by beginHandlerSet()
+    std::atomic<HandlerTable *> pendingHandlers;     // Published, waiting for the next tick boundary
+    const Mixer *activeMixer;
+    LogicEngine *activeLogic;
+    bool mixerPending;                               // Mixer changed, evaluate it on the next tick
+    ChannelMask pendingChannels;                     // Channels whose handlers need a dispatch
+    void applyPendingHandlerSet();
+    Mixer &standbyMixer() { return mixers[standbyHandlers - handlerSets]; }
+    LogicEngine &standbyLogic() { return logics[standbyHandlers - handlerSets]; }
+
+    // Receiver input, one decoder per protocol and the one in use
+    CrsfDecoder crsf;
+    SbusDecoder sbus;
+    IbusDecoder ibus;
+    PpmDecoder ppm;
+    InputDecoder *input;
+    InputProtocol inputProtocol;
+    std::atomic<int> pendingInputProtocol; // Waiting for the next tick boundary, -1 if none
+    HardwareSerial *crsfSerial;           // UART of the serial protocols
+    CrsfBaudNegotiator baudNegotiator;
+    void beginInput(InputProtocol protocol);
+    void applyPendingInputProtocol();
     BoardComputerStatus status;
 
-    // New members for signal tracking
-    unsigned long lastValidSignalTime;
-    static const unsigned long SIGNAL_TIMEOUT_MS = 1000; // 1 second timeout
+    // Telemetry downlink, filled into the slots received frames open
+    CrsfTelemetry telemetry;
+    uint8_t telemetryBatteryChannel;
+    uint16_t telemetryBatteryRatio;
+    void sendTelemetry(unsigned long currentTime);
+    const char *getFlightMode() const;
+
+    // Signal loss detection and staged failsafe
+    uint16_t failsafeFrameGapMs;
+    uint8_t failsafeMinLinkQuality;
+    FailsafeStats failsafeStats;
     bool errorState;
+    bool hasValidSignal(unsigned long currentTime) const;
+    void updateFailsafeStage(bool validSignal, unsigned long currentTime);
+    static FailsafeStage stagedFailsafeValue(const FailsafeProfile &profile, uint16_t lastValue,
+                                             unsigned long elapsedMs, uint16_t &value);
+
+    // Event driven input
+    TaskHandle_t taskHandle;
+    std::atomic<uint32_t> pendingFrameSinceUs; // micros() of the oldest frame not yet dispatched, 0 if none
+    std::atomic<uint32_t> framesCoalesced;     // Counted by the receiving task, inputStats only holds the control task's fields
+    InputStats inputStats;
+    void onInputReceive();
+    void waitForInput(TickType_t &lastWakeTime, TickType_t loopInterval);
+    void recordDispatch(uint32_t frameSince);
 
+    // Output commits, optionally aligned to the PWM periods
+    bool alignOutputCommits;
+    struct
+    {
+        uint32_t firstFrameUs;  // Oldest dispatched frame not on a pulse yet, 0 if none
+        uint32_t frameOffsetUs; // Sum of the later frames' distance to the first one
+        uint32_t frames;        // Frames waiting for a pulse
+        uint64_t latencySumUs;  // Frame to pulse latency of the frames in the current window
+        uint32_t latencyFrames;
+        uint32_t maxUs;
+    } pulseLatency;
+    TickType_t commitOutputs(uint32_t frameSince, TickType_t loopInterval);
+
+    // Edge triggered dispatch
+    struct
+    {
+        uint32_t calls;
+        uint32_t skipped;
+        uint32_t writes;
+        uint32_t writesSkipped;
+        uint32_t maxTickUs;
+        unsigned long windowStart;
+    } dispatchCounters;
+    DispatchStats dispatchStats;
+    uint32_t lastTickUs;
     void executeChannelHandlers();
-    void statusLedTaskHandler(void *pvParameters);
+    /**
+     * @brief Change the status and show it on the status LED right away
+     */
+    void setStatus(BoardComputerStatus newStatus);
 };
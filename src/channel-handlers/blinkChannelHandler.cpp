@@ -1,59 +1,48 @@
 #include "blinkChannelHandler.hpp"
 
-BlinkChannelHandler::BlinkChannelHandler(uint8_t pin, uint16_t onDurationMs, uint16_t offDurationMs)
+BlinkChannelHandler::BlinkChannelHandler(PatternScheduler &scheduler, uint8_t pin, PatternProgram *program,
+                                         uint8_t phaseGroup)
+    : scheduler(scheduler)
 {
+    this->program = program;
     this->pin = pin;
-    this->onDurationMs = onDurationMs;
-    this->offDurationMs = offDurationMs;
+    this->phaseGroup = phaseGroup;
+    this->outputId = -1;
     this->isBlinking = false;
-    this->blinkTaskHandle = NULL;
+}
+
+BlinkChannelHandler::~BlinkChannelHandler()
+{
+    this->program->release();
+}
+
+void BlinkChannelHandler::attach()
+{
     pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    this->outputId = scheduler.add(pin, phaseGroup, 0, false);
 }
 
-void BlinkChannelHandler::isOnWhen(std::function<bool(uint16_t value)> isOn)
+void BlinkChannelHandler::detach()
 {
-    this->isOn = isOn;
+    // Switches the pin off, the scheduler does not touch it afterwards
+    scheduler.remove(this->outputId);
+    this->outputId = -1;
+    this->isBlinking = false;
 }
 
-void BlinkChannelHandler::onChannelChange(uint16_t value)
+void BlinkChannelHandler::isOnWhen(const ThresholdPredicate &isOn)
 {
-    bool shouldBlink = this->isOn(value);
-    
-    if (shouldBlink != this->isBlinking) {
-        this->isBlinking = shouldBlink;
-        
-        if (shouldBlink) {
-            // Start blink task if not already running
-            if (this->blinkTaskHandle == NULL) {
-                xTaskCreate(
-                    [](void *pvParameters) -> void
-                    { static_cast<BlinkChannelHandler *>(pvParameters)->blinkTaskHandler(pvParameters); },
-                    "BlinkTask",
-                    1000,
-                    this,
-                    1,
-                    &this->blinkTaskHandle
-                );
-            }
-        } else {
-            // Stop blink task if running
-            if (this->blinkTaskHandle != NULL) {
-                vTaskDelete(this->blinkTaskHandle);
-                this->blinkTaskHandle = NULL;
-                digitalWrite(this->pin, LOW); // Ensure LED is off when stopping
-            }
-        }
-    }
+    this->isOn = isOn;
 }
 
-void BlinkChannelHandler::blinkTaskHandler(void *pvParameters)
+void BlinkChannelHandler::onChannelChange(uint16_t value)
 {
-    BlinkChannelHandler *handler = (BlinkChannelHandler *)pvParameters;
-    while (true)
+    bool shouldBlink = this->isOn.evaluate(value);
+
+    if (shouldBlink != this->isBlinking)
     {
-        digitalWrite(handler->pin, HIGH);
-        vTaskDelay(pdMS_TO_TICKS(handler->onDurationMs));
-        digitalWrite(handler->pin, LOW);
-        vTaskDelay(pdMS_TO_TICKS(handler->offDurationMs));
+        this->isBlinking = shouldBlink;
+        scheduler.setProgram(this->outputId, shouldBlink ? this->program : nullptr);
     }
-}
\ No newline at end of file
+}
@@ -1,20 +1,28 @@
 #pragma once
 
 #include "bordcomputer.hpp"
+#include "pattern_scheduler.hpp"
+#include "thresholdPredicate.hpp"
 
 class BlinkChannelHandler : public IChannelHandler
 {
 public:
-    BlinkChannelHandler(uint8_t pin, uint16_t onDurationMs, uint16_t offDurationMs);
-    void isOnWhen(std::function<bool(uint16_t value)> isOn);
+    /**
+     * @param program On/off program from PatternPool, released when the handler is destroyed
+     */
+    BlinkChannelHandler(PatternScheduler &scheduler, uint8_t pin, PatternProgram *program, uint8_t phaseGroup);
+    ~BlinkChannelHandler();
+    void isOnWhen(const ThresholdPredicate &isOn);
+    void attach() override;
+    void detach() override;
     void onChannelChange(uint16_t value);
 
 private:
+    PatternScheduler &scheduler;
+    PatternProgram *program;
     uint8_t pin;
-    std::function<bool(uint16_t value)> isOn;
-    uint16_t onDurationMs;
-    uint16_t offDurationMs;
+    uint8_t phaseGroup;
+    int8_t outputId; // Output in the scheduler while attached, -1 otherwise
+    ThresholdPredicate isOn;
     bool isBlinking;
-    TaskHandle_t blinkTaskHandle;
-    void blinkTaskHandler(void *pvParameters);
 };
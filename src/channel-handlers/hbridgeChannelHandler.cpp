@@ -0,0 +1,158 @@
+#include "hbridgeChannelHandler.hpp"
+#include "logger.hpp"
+
+HBridgeChannelHandler::HBridgeChannelHandler(LedcDriver &ledc, OutputShadow &outputs, uint8_t pinA, uint8_t pinB,
+                                             uint16_t frequencyHz, uint8_t resolutionBits, bool inverted,
+                                             uint16_t deadband, uint16_t deadTimeMs, uint16_t rampMs,
+                                             HBridgeStopMode failsafeMode)
+    : ledc(ledc), outputs(outputs), pinA(pinA), pinB(pinB), channelA(-1), channelB(-1),
+      resolutionBits(resolutionBits), failsafeMode(failsafeMode), frequencyHz(frequencyHz), deadband(deadband),
+      deadTimeMs(deadTimeMs), rampMs(rampMs), inverted(inverted), failsafe(false), driving(false), lastDirection(0),
+      target(0), speed(0), lastTickUs(0), stoppedAtUs(0)
+{
+}
+
+void HBridgeChannelHandler::attach()
+{
+    channelA = ledc.attach(pinA, frequencyHz, resolutionBits);
+    channelB = channelA >= 0 ? ledc.attach(pinB, frequencyHz, resolutionBits) : -1;
+    if (channelB < 0)
+    {
+        // Never drive half a bridge
+        ledc.detach(channelA);
+        channelA = -1;
+        LOG.errorf("HBridgeHandler", "Failed to initialize PWM on pins %d/%d", pinA, pinB);
+        return;
+    }
+
+    speed = 0;
+    driving = false;
+    lastDirection = 0;
+    lastTickUs = 0;
+    write();
+    LOG.debugf("HBridgeHandler", "Initialized on pins %d/%d at %dHz, %d bits (deadband: %dus, dead-time: %dms, ramp: %dms)",
+               pinA, pinB, frequencyHz, resolutionBits, deadband, deadTimeMs, rampMs);
+}
+
+void HBridgeChannelHandler::detach()
+{
+    if (channelA >= 0)
+    {
+        outputs.dropDuty(channelA);
+        outputs.dropDuty(channelB);
+        ledc.detach(channelA);
+        ledc.detach(channelB);
+    }
+    channelA = -1;
+    channelB = -1;
+}
+
+void HBridgeChannelHandler::onChannelChange(uint16_t value)
+{
+    // Kept during failsafe as well, so the motor ramps back to the channel once the signal returns
+    target = toSpeed(value);
+}
+
+void HBridgeChannelHandler::onFailsafe(bool active)
+{
+    failsafe = active;
+}
+
+bool HBridgeChannelHandler::onTick(uint32_t nowUs)
+{
+    if (channelA < 0)
+    {
+        return false;
+    }
+
+    if (failsafe)
+    {
+        // Stop without ramping, the ramp starts over from standstill once the signal is back
+        speed = 0;
+        if (driving)
+        {
+            driving = false;
+            stoppedAtUs = nowUs;
+        }
+        lastTickUs = 0;
+        write();
+        return false;
+    }
+
+    uint32_t elapsedUs = lastTickUs != 0 ? nowUs - lastTickUs : 0;
+    lastTickUs = nowUs != 0 ? nowUs : 1;
+
+    // A reversal ramps down to standstill first
+    int32_t goal = (speed > 0 && target < 0) || (speed < 0 && target > 0) ? 0 : target;
+    if (rampMs == 0)
+    {
+        speed = goal;
+    }
+    else
+    {
+        int32_t step = min((uint64_t)elapsedUs * HBRIDGE_FULL_SPEED / (rampMs * 1000UL), (uint64_t)HBRIDGE_FULL_SPEED);
+        speed = speed < goal ? min(speed + step, goal) : max(speed - step, goal);
+    }
+
+    bool waiting = false;
+    int8_t direction = speed > 0 ? 1 : speed < 0 ? -1 : 0;
+    if (direction == 0)
+    {
+        if (driving)
+        {
+            driving = false;
+            stoppedAtUs = nowUs;
+        }
+    }
+    else if (!driving)
+    {
+        // Both sides stay low for the dead-time before the bridge is driven the other way
+        if (direction != lastDirection && lastDirection != 0 && nowUs - stoppedAtUs < deadTimeMs * 1000UL)
+        {
+            speed = 0;
+            waiting = true;
+        }
+        else
+        {
+            driving = true;
+            lastDirection = direction;
+        }
+    }
+
+    write();
+    return waiting || speed != target;
+}
+
+int32_t HBridgeChannelHandler::toSpeed(uint16_t value) const
+{
+    int32_t offset = (int32_t)value - CHANNEL_MID;
+    if (inverted)
+    {
+        offset = -offset;
+    }
+
+    int32_t magnitude = abs(offset) - deadband;
+    if (magnitude <= 0)
+    {
+        return 0;
+    }
+
+    int32_t span = (CHANNEL_MAX - CHANNEL_MID) - deadband;
+    int32_t speed = min((int64_t)magnitude * HBRIDGE_FULL_SPEED / span, (int64_t)HBRIDGE_FULL_SPEED);
+    return offset > 0 ? speed : -speed;
+}
+
+void HBridgeChannelHandler::write()
+{
+    uint32_t fullDuty = ledc.getFullDuty(channelA);
+    if (failsafe && failsafeMode == HBridgeStopMode_BRAKE)
+    {
+        outputs.setDuty(channelA, fullDuty);
+        outputs.setDuty(channelB, fullDuty);
+        return;
+    }
+
+    uint32_t duty = ((uint64_t)abs(speed) * fullDuty) >> 16;
+    outputs.setDuty(channelA, speed > 0 ? duty : 0);
+    outputs.setDuty(channelB, speed < 0 ? duty : 0);
+}
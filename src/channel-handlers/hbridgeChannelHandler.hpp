@@ -0,0 +1,67 @@
+#pragma once
+
+#include "bordcomputer.hpp"
+#include "outputs/ledc_driver.hpp"
+#include "outputs/output_shadow.hpp"
+
+// Motor PWM well above hearing, 10 bits still fit the 80MHz LEDC clock
+#define HBRIDGE_DEFAULT_FREQUENCY 20000
+#define HBRIDGE_DEFAULT_RESOLUTION 10
+// Full speed in the Q16 fixed point the ramp runs in
+#define HBRIDGE_FULL_SPEED 65536
+
+enum HBridgeStopMode : uint8_t
+{
+    HBridgeStopMode_BRAKE, // Both sides high, the motor is shorted and holds the load
+    HBridgeStopMode_COAST  // Both sides low, the motor runs free
+};
+
+/**
+ * @brief Bidirectional motor on a pin pair driving an H-bridge in sign-magnitude mode
+ *
+ * The channel's center is stop, above it pin A is driven with the speed as duty and
+ * below it pin B. Speed changes are ramped every tick, a reversal first ramps down
+ * and keeps both sides low for the dead-time before the other side is driven.
+ * On failsafe the motor stops at once and brakes or coasts.
+ */
+class HBridgeChannelHandler : public IChannelHandler
+{
+public:
+    /**
+     * @param deadband µs around the center that count as stop
+     * @param rampMs Time from stop to full speed, 0 to follow the channel at once
+     */
+    HBridgeChannelHandler(LedcDriver &ledc, OutputShadow &outputs, uint8_t pinA, uint8_t pinB,
+                          uint16_t frequencyHz, uint8_t resolutionBits, bool inverted, uint16_t deadband,
+                          uint16_t deadTimeMs, uint16_t rampMs, HBridgeStopMode failsafeMode);
+    void attach() override;
+    void detach() override;
+    void onChannelChange(uint16_t value) override;
+    bool onTick(uint32_t nowUs) override;
+    void onFailsafe(bool active) override;
+
+private:
+    LedcDriver &ledc;
+    OutputShadow &outputs;
+    uint8_t pinA;
+    uint8_t pinB;
+    int8_t channelA; // LEDC channels while attached, -1 otherwise
+    int8_t channelB;
+    uint8_t resolutionBits;
+    HBridgeStopMode failsafeMode;
+    uint16_t frequencyHz;
+    uint16_t deadband;
+    uint16_t deadTimeMs;
+    uint16_t rampMs;
+    bool inverted;
+    bool failsafe;
+    bool driving;          // One side of the bridge is driven
+    int8_t lastDirection;  // Side driven last, 1 for A, -1 for B, 0 if never
+    int32_t target;        // Q16 speed the channel asks for, negative towards B
+    int32_t speed;         // Q16 speed currently output
+    uint32_t lastTickUs;   // 0 until the first tick after attach or failsafe
+    uint32_t stoppedAtUs;  // When driving last stopped, for the dead-time
+
+    int32_t toSpeed(uint16_t value) const;
+    void write();
+};
@@ -0,0 +1,156 @@
+#include "lightBarChannelHandler.hpp"
+#include "logger.hpp"
+
+LightBarChannelHandler::LightBarChannelHandler(Ws2812Driver &driver, uint8_t pin, uint16_t numPixels, uint32_t color,
+                                               bool inverted, PatternProgram *const programs[], uint8_t numPrograms,
+                                               uint16_t pixelOffsetMs, uint16_t hysteresis)
+    : driver(driver)
+{
+    this->numPrograms = min(numPrograms, (uint8_t)PATTERN_SLOTS);
+    for (uint8_t i = 0; i < PATTERN_SLOTS; i++)
+    {
+        this->programs[i] = i < this->numPrograms ? programs[i] : nullptr;
+    }
+    this->pin = pin;
+    this->numPixels = numPixels;
+    this->red = color >> 16;
+    this->green = color >> 8;
+    this->blue = color;
+    this->inverted = inverted;
+    this->pixelOffsetMs = pixelOffsetMs;
+    this->hysteresis = hysteresis;
+    this->strip = -1;
+    this->band = -1;
+    this->dirty = false;
+    this->value = CHANNEL_MIN;
+    this->lastFrameUs = 0;
+    this->epochMs = 0;
+}
+
+LightBarChannelHandler::~LightBarChannelHandler()
+{
+    for (uint8_t i = 0; i < numPrograms; i++)
+    {
+        if (programs[i] != nullptr)
+        {
+            programs[i]->release();
+        }
+    }
+}
+
+void LightBarChannelHandler::attach()
+{
+    this->strip = driver.attach(pin, numPixels);
+    this->band = -1;
+    this->dirty = true; // Start dark until the first value arrives
+    this->lastFrameUs = 0;
+}
+
+void LightBarChannelHandler::detach()
+{
+    if (strip >= 0)
+    {
+        // Leave the bar dark, detach() waits for the frame to go out
+        driver.clear(strip);
+        driver.detach(strip);
+    }
+    this->strip = -1;
+}
+
+void LightBarChannelHandler::onChannelChange(uint16_t value)
+{
+    this->value = value;
+    if (numPrograms == 0)
+    {
+        dirty = true;
+        return;
+    }
+
+    int8_t next = patternBandOf(value, band, numPrograms, hysteresis);
+
+    if (next != band)
+    {
+        band = next;
+        epochMs = millis(); // A new pattern starts at its first step
+        dirty = true;
+    }
+}
+
+bool LightBarChannelHandler::onTick(uint32_t nowUs)
+{
+    if (strip < 0)
+    {
+        return false;
+    }
+
+    bool animated = band >= 0 && programs[band] != nullptr;
+    if (!dirty && !animated)
+    {
+        return false;
+    }
+
+    // Keep ticking until the next frame is due
+    if (lastFrameUs != 0 && nowUs - lastFrameUs < WS2812_FRAME_INTERVAL_US)
+    {
+        return true;
+    }
+
+    if (numPrograms == 0)
+    {
+        renderBar();
+    }
+    else
+    {
+        // Same clock as epochMs, nowUs / 1000 jumps when micros() wraps after 71 minutes
+        renderPattern(millis());
+    }
+
+    if (!driver.show(strip))
+    {
+        return true; // Still transmitting, the frame goes out on a later tick
+    }
+
+    // Frames keep their own beat instead of the tick's, so 4ms ticks still give 100 frames per second
+    if (lastFrameUs != 0 && nowUs - lastFrameUs < 2 * WS2812_FRAME_INTERVAL_US)
+    {
+        lastFrameUs += WS2812_FRAME_INTERVAL_US;
+    }
+    else
+    {
+        lastFrameUs = nowUs;
+    }
+    lastFrameUs = lastFrameUs != 0 ? lastFrameUs : 1;
+    dirty = false;
+    return animated;
+}
+
+void LightBarChannelHandler::renderBar()
+{
+    // Lit length in 1/256 pixel
+    uint32_t range = CHANNEL_MAX - CHANNEL_MIN;
+    uint32_t lit = (uint32_t)(constrain(value, CHANNEL_MIN, CHANNEL_MAX) - CHANNEL_MIN) * numPixels * 256 / range;
+    for (uint16_t i = 0; i < numPixels; i++)
+    {
+        uint32_t start = (uint32_t)i * 256;
+        setPixel(i, lit >= start + 256 ? 255 : lit > start ? lit - start : 0);
+    }
+}
+
+void LightBarChannelHandler::renderPattern(uint32_t nowMs)
+{
+    const PatternProgram *program = band >= 0 ? programs[band] : nullptr;
+    uint32_t phaseMs = nowMs - epochMs;
+    for (uint16_t i = 0; i < numPixels; i++)
+    {
+        setPixel(i, program != nullptr ? program->levelAt(phaseMs + (uint32_t)i * pixelOffsetMs) : 0);
+    }
+}
+
+void LightBarChannelHandler::setPixel(uint16_t index, uint8_t level)
+{
+    if (inverted)
+    {
+        index = numPixels - 1 - index;
+    }
+    driver.setPixel(strip, index, red * level / 255, green * level / 255, blue * level / 255);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "bordcomputer.hpp"
+#include "patternProgram.hpp"
+#include "outputs/ws2812_driver.hpp"
+
+/**
+ * @brief WS2812 light bar in one colour, as a bar graph of the channel or running patterns
+ *
+ * Without programs the channel fills the bar from its first pixel, the last lit pixel
+ * dimmed by the remainder. With programs the channel range is split into equal bands
+ * like for sequence outputs, each pixel runs the band's pattern pixelOffsetMs ahead of
+ * the one before, which turns a single fade into a chaser. Frames are rendered in the
+ * control task's tick at up to 100Hz and sent by the RMT in the background.
+ */
+class LightBarChannelHandler : public IChannelHandler
+{
+public:
+    /**
+     * @param programs One program per band from PatternPool, nullptr for off, released when the handler is destroyed
+     * @param hysteresis µs the value has to move past a band boundary before the pattern switches
+     */
+    LightBarChannelHandler(Ws2812Driver &driver, uint8_t pin, uint16_t numPixels, uint32_t color, bool inverted,
+                           PatternProgram *const programs[], uint8_t numPrograms, uint16_t pixelOffsetMs,
+                           uint16_t hysteresis);
+    ~LightBarChannelHandler();
+    void attach() override;
+    void detach() override;
+    void onChannelChange(uint16_t value) override;
+    bool onTick(uint32_t nowUs) override;
+
+private:
+    Ws2812Driver &driver;
+    PatternProgram *programs[PATTERN_SLOTS];
+    uint8_t numPrograms;
+    uint8_t pin;
+    int8_t strip; // Strip in the driver while attached, -1 otherwise
+    int8_t band;  // Pattern band the value was last in, -1 before the first value
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    bool inverted;
+    bool dirty; // The bar graph changed since the last frame
+    uint16_t numPixels;
+    uint16_t pixelOffsetMs;
+    uint16_t hysteresis;
+    uint16_t value;
+    uint32_t lastFrameUs;
+    uint32_t epochMs; // Pattern time of the first pixel starts here
+
+    void renderBar();
+    void renderPattern(uint32_t nowMs);
+    void setPixel(uint16_t index, uint8_t level);
+};
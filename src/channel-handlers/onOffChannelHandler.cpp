@@ -1,22 +1,40 @@
 #include "onOffChannelHandler.hpp"
 #include "logger.hpp"
 
-OnOffChannelHandler::OnOffChannelHandler(uint8_t pin) : pin(pin)
+OnOffChannelHandler::OnOffChannelHandler(OutputShadow &outputs, uint8_t pin) : outputs(outputs), pin(pin), isOnState(false)
 {
-    pinMode(pin, OUTPUT);
-    digitalWrite(pin, LOW); // Initialize to OFF state
+}
+
+void OnOffChannelHandler::attach()
+{
+    outputs.claim(pin);
+    outputs.setDigital(pin, false); // Initialize to OFF state
+    isOnState = false;
     LOG.debugf("OnOffHandler", "Initialized on pin %d", pin);
 }
 
-void OnOffChannelHandler::isOnWhen(std::function<bool(uint16_t value)> isOn)
+void OnOffChannelHandler::detach()
+{
+    // Low before the next handler attaches, the end of this tick may be after that
+    outputs.release(pin);
+    isOnState = false;
+}
+
+void OnOffChannelHandler::isOnWhen(const ThresholdPredicate &isOn)
 {
     this->isOn = isOn;
 }
 
 void OnOffChannelHandler::onChannelChange(uint16_t value)
 {
-    bool shouldBeOn = this->isOn(value);
-    digitalWrite(pin, shouldBeOn ? HIGH : LOW);
+    bool shouldBeOn = this->isOn.evaluate(value);
+    if (shouldBeOn == this->isOnState)
+    {
+        return; // The channel moved but the output does not change
+    }
+
+    this->isOnState = shouldBeOn;
+    outputs.setDigital(pin, shouldBeOn); // Switched with all other outputs at the end of the tick
     LOG.debugf("OnOffHandler", "Pin %d set to %s (value: %d)",
                pin, shouldBeOn ? "ON" : "OFF", value);
 }
\ No newline at end of file
@@ -1,15 +1,21 @@
 #pragma once
 
 #include "../bordcomputer.hpp"
+#include "thresholdPredicate.hpp"
+#include "outputs/output_shadow.hpp"
 
 class OnOffChannelHandler : public IChannelHandler
 {
 public:
-    OnOffChannelHandler(uint8_t pin);
-    void isOnWhen(std::function<bool(uint16_t value)> isOn);
+    OnOffChannelHandler(OutputShadow &outputs, uint8_t pin);
+    void isOnWhen(const ThresholdPredicate &isOn);
+    void attach() override;
+    void detach() override;
     void onChannelChange(uint16_t value);
 
 private:
+    OutputShadow &outputs;
     uint8_t pin;
-    std::function<bool(uint16_t value)> isOn;
+    ThresholdPredicate isOn;
+    bool isOnState;
 };
@@ -0,0 +1,184 @@
+#include "patternProgram.hpp"
+#include "logger.hpp"
+#include "channels.hpp"
+
+PatternConfig::PatternConfig()
+{
+    numSteps = 0;
+    memset(padding, 0, sizeof(padding));
+    memset(steps, 0, sizeof(steps));
+}
+
+bool PatternConfig::operator==(const PatternConfig &other) const
+{
+    if (numSteps != other.numSteps)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < numSteps; i++)
+    {
+        if (steps[i].level != other.steps[i].level || steps[i].fade != other.steps[i].fade ||
+            steps[i].durationMs != other.steps[i].durationMs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+PatternConfig PatternConfig::blink(uint16_t onMs, uint16_t offMs)
+{
+    PatternConfig config;
+    config.numSteps = 2;
+    config.steps[0].level = 255;
+    config.steps[0].durationMs = onMs;
+    config.steps[1].level = 0;
+    config.steps[1].durationMs = offMs;
+    return config;
+}
+
+void PatternProgram::compile(const PatternConfig &config)
+{
+    length = 0;
+    dimmable = false;
+    periodMs = 0;
+
+    for (uint8_t i = 0; i < config.numSteps && i < PATTERN_MAX_STEPS; i++)
+    {
+        const PatternStep &step = config.steps[i];
+        if (step.durationMs == 0)
+        {
+            continue;
+        }
+
+        // A step that holds the level of the one before just extends it
+        if (length > 0 && !step.fade && !steps[length - 1].fade && steps[length - 1].level == step.level &&
+            (uint32_t)steps[length - 1].durationMs + step.durationMs <= UINT16_MAX)
+        {
+            steps[length - 1].durationMs += step.durationMs;
+        }
+        else
+        {
+            steps[length++] = step;
+        }
+
+        periodMs += step.durationMs;
+        dimmable |= step.fade || (step.level != 0 && step.level != 255);
+    }
+}
+
+uint8_t PatternProgram::levelAt(uint32_t phaseMs) const
+{
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    phaseMs %= periodMs;
+    uint8_t step = 0;
+    while (phaseMs >= steps[step].durationMs)
+    {
+        phaseMs -= steps[step].durationMs;
+        step++;
+    }
+
+    if (!steps[step].fade)
+    {
+        return steps[step].level;
+    }
+    const PatternStep &previous = steps[step > 0 ? step - 1 : length - 1];
+    return previous.level + ((int)steps[step].level - previous.level) * (int32_t)phaseMs / steps[step].durationMs;
+}
+
+bool PatternProgram::sameSteps(const PatternProgram &other) const
+{
+    if (length != other.length)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++)
+    {
+        if (steps[i].level != other.steps[i].level || steps[i].fade != other.steps[i].fade ||
+            steps[i].durationMs != other.steps[i].durationMs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+PatternProgram *PatternPool::acquire(const PatternConfig &config)
+{
+    // Patterns that compile to the same steps share a program, however they were written
+    PatternProgram compiled;
+    compiled.compile(config);
+    if (compiled.periodMs == 0)
+    {
+        LOG.error("PatternPool", "Pattern has no steps");
+        return nullptr;
+    }
+
+    PatternProgram *unused = nullptr;
+    for (size_t i = 0; i < PATTERN_POOL_SIZE; i++)
+    {
+        PatternProgram &program = programs[i];
+        if (program.users > 0 && program.sameSteps(compiled))
+        {
+            program.users++;
+            return &program;
+        }
+        if (program.users == 0 && unused == nullptr)
+        {
+            unused = &program;
+        }
+    }
+
+    if (unused == nullptr)
+    {
+        LOG.errorf("PatternPool", "All %d pattern programs are in use", PATTERN_POOL_SIZE);
+        return nullptr;
+    }
+
+    *unused = compiled;
+    unused->users = 1;
+    LOG.debugf("PatternPool", "Pattern compiled to %d steps, %lums period, %d bytes",
+               unused->length, unused->periodMs, sizeof(PatternProgram));
+    return unused;
+}
+
+size_t PatternPool::used() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < PATTERN_POOL_SIZE; i++)
+    {
+        count += programs[i].users > 0;
+    }
+    return count;
+}
+
+static uint8_t bandOf(int value, uint8_t numBands)
+{
+    value = constrain(value, CHANNEL_MIN, CHANNEL_MAX);
+    return min((value - CHANNEL_MIN) * numBands / (CHANNEL_MAX - CHANNEL_MIN + 1), numBands - 1);
+}
+
+int8_t patternBandOf(uint16_t value, int8_t band, uint8_t numBands, uint16_t hysteresis)
+{
+    if (numBands == 0)
+    {
+        return -1;
+    }
+
+    int8_t next = bandOf(value, numBands);
+
+    // Only leave the current band once the value is clearly past its boundary
+    if (band >= 0 && next > band)
+    {
+        next = max((int)band, (int)bandOf(value - hysteresis, numBands));
+    }
+    else if (band >= 0 && next < band)
+    {
+        next = min((int)band, (int)bandOf(value + hysteresis, numBands));
+    }
+    return next;
+}
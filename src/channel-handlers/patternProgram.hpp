@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define PATTERN_MAX_STEPS 16
+// Patterns a configuration can define, referenced by number 1..PATTERN_COUNT
+#define PATTERN_COUNT 8
+// Patterns of all outputs plus the blink timings, with room for a new configuration while the old one still runs
+#define PATTERN_POOL_SIZE 24
+// Patterns a sequence output switches between
+#define PATTERN_SLOTS 4
+
+struct PatternStep
+{
+    uint8_t level;       // 0..255, anything between 0 and 255 needs a PWM pin
+    bool fade;           // Ramp from the previous step's level instead of jumping
+    uint16_t durationMs;
+};
+
+/**
+ * @brief Pattern as stored in the configuration
+ */
+struct PatternConfig
+{
+    uint8_t numSteps;
+    uint8_t padding[3];
+    PatternStep steps[PATTERN_MAX_STEPS];
+
+    PatternConfig();
+    bool operator==(const PatternConfig &other) const;
+    bool operator!=(const PatternConfig &other) const { return !(*this == other); }
+
+    /**
+     * @brief On for onMs, then off for offMs
+     */
+    static PatternConfig blink(uint16_t onMs, uint16_t offMs);
+};
+
+/**
+ * @brief Pattern compiled for the scheduler
+ *
+ * Zero length steps are dropped and neighbouring steps with the same level are merged,
+ * so the scheduler only wakes up for real edges and fades. A fade in the first step
+ * starts from the level of the last one.
+ */
+class PatternProgram
+{
+public:
+    PatternProgram() : length(0), dimmable(false), users(0), periodMs(0) {}
+
+    PatternStep steps[PATTERN_MAX_STEPS];
+    uint8_t length;
+    bool dimmable; // Needs PWM, some level is neither off nor full or a step fades
+    uint8_t users;
+    uint32_t periodMs;
+
+    /**
+     * @brief Level at a point of the period, for outputs that render patterns themselves
+     * @param phaseMs Time since the start of a period, wrapped into the period
+     */
+    uint8_t levelAt(uint32_t phaseMs) const;
+
+    /**
+     * @brief Drop one user, the program's slot is reused once nobody holds it
+     */
+    void release()
+    {
+        if (users > 0)
+        {
+            users--;
+        }
+    }
+
+private:
+    friend class PatternPool;
+
+    void compile(const PatternConfig &config);
+    bool sameSteps(const PatternProgram &other) const;
+};
+
+/**
+ * @brief Pattern band a channel value selects, for outputs that split the channel range into equal bands
+ * @param band Band the value was last in, -1 before the first value
+ * @param hysteresis µs the value has to move past a band boundary before the band changes
+ * @return -1 if there are no bands
+ */
+int8_t patternBandOf(uint16_t value, int8_t band, uint8_t numBands, uint16_t hysteresis);
+
+/**
+ * @brief Fixed set of compiled patterns, outputs with identical patterns share one program
+ *
+ * Only used from the configuration side, the scheduler just reads the programs.
+ */
+class PatternPool
+{
+public:
+    /**
+     * @brief Get the program for config, compiling it if no output uses the same pattern yet
+     * @return nullptr if the pattern is empty or all programs are in use
+     */
+    PatternProgram *acquire(const PatternConfig &config);
+
+    size_t used() const;
+
+private:
+    PatternProgram programs[PATTERN_POOL_SIZE];
+};
@@ -1,51 +1,77 @@
 #include "pwmChannelHandler.hpp"
 #include "logger.hpp"
 
-bool PWMChannelHandler::isGlobalSetupDone = false;
-
-PWMChannelHandler::PWMChannelHandler(uint8_t pin, uint16_t min, uint16_t max) : pin(pin)
+PWMChannelHandler::PWMChannelHandler(LedcDriver &ledc, OutputShadow &outputs, uint8_t pin, ResponseCurve *curve, uint16_t frequencyHz,
+                                     uint8_t resolutionBits, PWMUnit unit, uint16_t min, uint16_t max)
+    : ledc(ledc), outputs(outputs), channel(-1), pin(pin), resolutionBits(resolutionBits), unit(unit), frequencyHz(frequencyHz),
+      dutyLow(0), dutyHigh(0), curve(curve)
 {
-    pinMode(pin, OUTPUT);
     this->min = min;
     this->max = max;
-    this->inverted = false;
+    this->initialPosition = CHANNEL_MIN;
+}
 
-    // Configure servo - let ESP32Servo handle timer allocation dynamically
-    this->output.setPeriodHertz(50); // Standard 50hz servo
-    if (this->output.attach(pin, min, max))
-    {
-        LOG.debugf("PWMHandler", "Initialized servo on pin %d (range: %d-%d)", pin, min, max);
-    }
-    else
-    {
-        LOG.errorf("PWMHandler", "Failed to initialize servo on pin %d", pin);
-    }
+PWMChannelHandler::~PWMChannelHandler()
+{
+    this->curve->release();
 }
 
 void PWMChannelHandler::setup(uint16_t initialPosition)
 {
-    // Set initial position
-    this->output.writeMicroseconds(initialPosition);
-    LOG.debugf("PWMHandler", "Set initial position to %d on pin %d", initialPosition, pin);
+    // Written when the handler goes live
+    this->initialPosition = initialPosition;
 }
 
-void PWMChannelHandler::onChannelChange(uint16_t value)
+void PWMChannelHandler::attach()
 {
-    // For servos, we want to use the raw channel value (1000-2000) directly
-    // but constrain it to our min/max range
-    uint16_t constrainedValue = value;
-    if (this->inverted)
+    this->channel = ledc.attach(pin, frequencyHz, resolutionBits);
+    if (this->channel < 0)
     {
-        constrainedValue = map(value, CHANNEL_MIN, CHANNEL_MAX, CHANNEL_MAX, CHANNEL_MIN);
+        LOG.errorf("PWMHandler", "Failed to initialize PWM on pin %d", pin);
+        return;
     }
 
-    constrainedValue = constrain(constrainedValue, this->min, this->max);
+    uint32_t fullDuty = ledc.getFullDuty(channel);
+    dutyLow = fullDuty * min / 100;
+    dutyHigh = fullDuty * max / 100;
+    LOG.debugf("PWMHandler", "Initialized PWM on pin %d at %dHz, %d bits (range: %d-%d%s)",
+               pin, frequencyHz, resolutionBits, min, max, unit == PWMUnit_PERCENT ? "%" : "us");
+
+    write(initialPosition);
+    LOG.debugf("PWMHandler", "Set initial position to %d on pin %d", initialPosition, pin);
+}
+
+void PWMChannelHandler::detach()
+{
+    if (this->channel >= 0)
+    {
+        outputs.dropDuty(this->channel);
+    }
+    ledc.detach(this->channel);
+    this->channel = -1;
+}
 
-    this->output.writeMicroseconds(constrainedValue);
+void PWMChannelHandler::onChannelChange(uint16_t value)
+{
+    write(value);
 }
 
-void PWMChannelHandler::setInverted(bool inverted)
+void PWMChannelHandler::write(uint16_t value)
 {
-    LOG.infof("PWMHandler", "Setting pin %d to inverted: %s", this->pin, inverted ? "yes" : "no");
-    this->inverted = inverted;
+    if (this->channel < 0)
+    {
+        return;
+    }
+
+    // Reverse, expo, endpoints and limits are all compiled into the curve
+    uint16_t output = this->curve->lookup(value);
+    if (unit == PWMUnit_PERCENT)
+    {
+        int32_t span = (int32_t)dutyHigh - (int32_t)dutyLow;
+        outputs.setDuty(channel, dutyLow + span * (output - CHANNEL_MIN) / (CHANNEL_MAX - CHANNEL_MIN));
+    }
+    else
+    {
+        outputs.setDuty(channel, ledc.microsecondsToDuty(channel, output));
+    }
 }
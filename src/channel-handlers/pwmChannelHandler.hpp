@@ -1,27 +1,52 @@
 #pragma once
 
 #include "bordcomputer.hpp"
+#include "responseCurve.hpp"
+#include "outputs/ledc_driver.hpp"
+#include "outputs/output_shadow.hpp"
 
 #define PWM_MIN 1000
 #define PWM_MAX 2000
 #define PWM_CENTER (PWM_MAX - PWM_MIN) / 2
+#define PWM_DEFAULT_FREQUENCY 50
+#define PWM_DEFAULT_RESOLUTION 14
 
-// Define the type for the mapping function
-typedef int (*PWMMappingFunction)(uint16_t channelValue, uint16_t min, uint16_t max);
+enum PWMUnit : uint8_t
+{
+    PWMUnit_MICROSECONDS, // Curve output is the pulse width, for servos and ESCs
+    PWMUnit_PERCENT       // Channel range maps onto min..max % duty, for lights and motors
+};
 
 class PWMChannelHandler : public IChannelHandler
 {
 public:
-    PWMChannelHandler(uint8_t pin, uint16_t min = PWM_MIN, uint16_t max = PWM_MAX);
+    /**
+     * @param curve Compiled response curve, released when the handler is destroyed
+     * @param min Lowest output, µs or % depending on unit
+     * @param max Highest output, µs or % depending on unit
+     */
+    PWMChannelHandler(LedcDriver &ledc, OutputShadow &outputs, uint8_t pin, ResponseCurve *curve, uint16_t frequencyHz, uint8_t resolutionBits,
+                      PWMUnit unit, uint16_t min = PWM_MIN, uint16_t max = PWM_MAX);
+    ~PWMChannelHandler();
     void setup(uint16_t initialPosition = PWM_MIN);
+    void attach() override;
+    void detach() override;
     void onChannelChange(uint16_t value) override;
-    void setInverted(bool inverted);
 
 private:
-    static bool isGlobalSetupDone;
+    LedcDriver &ledc;
+    OutputShadow &outputs;
+    int8_t channel; // LEDC channel while attached, -1 otherwise
     uint8_t pin;
-    Servo output;
+    uint8_t resolutionBits;
+    PWMUnit unit;
+    uint16_t frequencyHz;
     uint16_t min;
     uint16_t max;
-    bool inverted;
+    uint16_t initialPosition;
+    uint32_t dutyLow; // PWMUnit_PERCENT: duty at CHANNEL_MIN and CHANNEL_MAX
+    uint32_t dutyHigh;
+    ResponseCurve *curve;
+
+    void write(uint16_t value);
 };
@@ -0,0 +1,122 @@
+#include "responseCurve.hpp"
+#include "logger.hpp"
+
+CurveParams::CurveParams()
+    : min(CHANNEL_MIN), max(CHANNEL_MAX), subtrim(0), expo(0), endpointLow(100), endpointHigh(100),
+      reverse(false), numPoints(0)
+{
+    memset(points, 0, sizeof(points));
+}
+
+bool CurveParams::operator==(const CurveParams &other) const
+{
+    return min == other.min && max == other.max && subtrim == other.subtrim && expo == other.expo &&
+           endpointLow == other.endpointLow && endpointHigh == other.endpointHigh &&
+           reverse == other.reverse && numPoints == other.numPoints &&
+           memcmp(points, other.points, numPoints) == 0;
+}
+
+// Monotone cubic (Fritsch-Carlson) through evenly spaced points, x in 0..1
+static float interpolatePoints(const int8_t *points, uint8_t numPoints, float x)
+{
+    const int segments = numPoints - 1;
+    float position = x * segments;
+    int segment = constrain((int)position, 0, segments - 1);
+    float t = position - segment;
+
+    float y0 = points[segment];
+    float y1 = points[segment + 1];
+    float delta = y1 - y0;
+
+    // Tangents from the neighbouring secants, flattened at extrema to avoid overshoot
+    float secantBefore = segment > 0 ? y0 - points[segment - 1] : delta;
+    float secantAfter = segment < segments - 1 ? points[segment + 2] - y1 : delta;
+    float m0 = (secantBefore * delta <= 0) ? 0 : (secantBefore + delta) / 2;
+    float m1 = (delta * secantAfter <= 0) ? 0 : (delta + secantAfter) / 2;
+    if (delta != 0)
+    {
+        float a = m0 / delta;
+        float b = m1 / delta;
+        float s = a * a + b * b;
+        if (s > 9)
+        {
+            float tau = 3 / sqrtf(s);
+            m0 = tau * a * delta;
+            m1 = tau * b * delta;
+        }
+    }
+
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return (2 * t3 - 3 * t2 + 1) * y0 + (t3 - 2 * t2 + t) * m0 + (-2 * t3 + 3 * t2) * y1 + (t3 - t2) * m1;
+}
+
+void ResponseCurve::compile(const CurveParams &params)
+{
+    this->params = params;
+    const float halfRange = (CHANNEL_MAX - CHANNEL_MIN) / 2.0f;
+
+    for (int i = 0; i < CURVE_TABLE_SIZE; i++)
+    {
+        // Deflection from center, -1..1
+        float x = (i - halfRange) / halfRange;
+        if (params.reverse)
+        {
+            x = -x;
+        }
+
+        if (params.expo != 0)
+        {
+            float k = params.expo / 100.0f;
+            x = x * (k * x * x + (1 - k));
+        }
+
+        if (params.numPoints >= 2)
+        {
+            x = interpolatePoints(params.points, params.numPoints, (x + 1) / 2) / 100.0f;
+        }
+
+        x *= (x < 0 ? params.endpointLow : params.endpointHigh) / 100.0f;
+
+        int value = lroundf(CHANNEL_MID + params.subtrim + x * halfRange);
+        table[i] = constrain(value, params.min, params.max);
+    }
+}
+
+ResponseCurve *CurvePool::acquire(const CurveParams &params)
+{
+    ResponseCurve *unused = nullptr;
+    for (size_t i = 0; i < CURVE_POOL_SIZE; i++)
+    {
+        ResponseCurve &curve = curves[i];
+        if (curve.users > 0 && curve.params == params)
+        {
+            curve.users++;
+            return &curve;
+        }
+        if (curve.users == 0 && unused == nullptr)
+        {
+            unused = &curve;
+        }
+    }
+
+    if (unused == nullptr)
+    {
+        LOG.errorf("CurvePool", "All %d curve tables are in use", CURVE_POOL_SIZE);
+        return nullptr;
+    }
+
+    unused->compile(params);
+    unused->users = 1;
+    return unused;
+}
+
+size_t CurvePool::used() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < CURVE_POOL_SIZE; i++)
+    {
+        count += curves[i].users > 0;
+    }
+    return count;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include "channels.hpp"
+
+#define CURVE_TABLE_SIZE (CHANNEL_MAX - CHANNEL_MIN + 1)
+#define CURVE_MAX_POINTS 9
+// Eight PWM pins, plus room for the curves of a new configuration while the old one still runs
+#define CURVE_POOL_SIZE 12
+
+/**
+ * @brief Shape of a PWM output, applied in this order to the channel's deflection from center
+ */
+struct CurveParams
+{
+    int16_t min;          // Hard output limits in µs
+    int16_t max;
+    int16_t subtrim;      // µs added to the center
+    int8_t expo;          // -100..100 %, positive softens the center
+    uint8_t endpointLow;  // Deflection below center, 0..150 %
+    uint8_t endpointHigh; // Deflection above center, 0..150 %
+    bool reverse;
+    uint8_t numPoints;    // Spline points evenly spread over the input range, 0 or 2..CURVE_MAX_POINTS
+    int8_t points[CURVE_MAX_POINTS]; // -100..100 % of full deflection
+
+    CurveParams();
+    bool operator==(const CurveParams &other) const;
+};
+
+/**
+ * @brief Response curve compiled into a table with one output value per input µs
+ */
+class ResponseCurve
+{
+public:
+    ResponseCurve() : users(0) {}
+
+    inline uint16_t lookup(uint16_t value) const
+    {
+        return table[constrain(value, CHANNEL_MIN, CHANNEL_MAX) - CHANNEL_MIN];
+    }
+
+    /**
+     * @brief Drop one user, the curve's slot is reused once nobody holds it
+     */
+    void release()
+    {
+        if (users > 0)
+        {
+            users--;
+        }
+    }
+
+private:
+    friend class CurvePool;
+
+    uint16_t table[CURVE_TABLE_SIZE];
+    CurveParams params;
+    uint8_t users;
+
+    void compile(const CurveParams &params);
+};
+
+/**
+ * @brief Fixed set of curve tables, outputs with identical curves share one table
+ *
+ * Only used from the configuration side, the control task just reads the tables.
+ */
+class CurvePool
+{
+public:
+    /**
+     * @brief Get the table for params, compiling it if no output uses the same curve yet
+     * @return nullptr if all tables are in use
+     */
+    ResponseCurve *acquire(const CurveParams &params);
+
+    size_t used() const;
+
+private:
+    ResponseCurve curves[CURVE_POOL_SIZE];
+};
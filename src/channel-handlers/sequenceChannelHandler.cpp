@@ -0,0 +1,62 @@
+#include "sequenceChannelHandler.hpp"
+
+SequenceChannelHandler::SequenceChannelHandler(PatternScheduler &scheduler, uint8_t pin, PatternProgram *const programs[],
+                                               uint8_t numPrograms, uint8_t phaseGroup, uint16_t phaseOffsetMs,
+                                               uint16_t hysteresis)
+    : scheduler(scheduler)
+{
+    this->numPrograms = min(numPrograms, (uint8_t)PATTERN_SLOTS);
+    for (uint8_t i = 0; i < PATTERN_SLOTS; i++)
+    {
+        this->programs[i] = i < this->numPrograms ? programs[i] : nullptr;
+    }
+    this->pin = pin;
+    this->phaseGroup = phaseGroup;
+    this->phaseOffsetMs = phaseOffsetMs;
+    this->hysteresis = hysteresis;
+    this->outputId = -1;
+    this->band = -1;
+}
+
+SequenceChannelHandler::~SequenceChannelHandler()
+{
+    for (uint8_t i = 0; i < numPrograms; i++)
+    {
+        if (programs[i] != nullptr)
+        {
+            programs[i]->release();
+        }
+    }
+}
+
+void SequenceChannelHandler::attach()
+{
+    bool dimmable = false;
+    for (uint8_t i = 0; i < numPrograms; i++)
+    {
+        dimmable |= programs[i] != nullptr && programs[i]->dimmable;
+    }
+
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    this->outputId = scheduler.add(pin, phaseGroup, phaseOffsetMs, dimmable);
+}
+
+void SequenceChannelHandler::detach()
+{
+    // Switches the pin off, the scheduler does not touch it afterwards
+    scheduler.remove(this->outputId);
+    this->outputId = -1;
+    this->band = -1;
+}
+
+void SequenceChannelHandler::onChannelChange(uint16_t value)
+{
+    int8_t next = patternBandOf(value, band, numPrograms, hysteresis);
+
+    if (next != band)
+    {
+        band = next;
+        scheduler.setProgram(this->outputId, programs[band]);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "bordcomputer.hpp"
+#include "pattern_scheduler.hpp"
+
+/**
+ * @brief Runs one of several light patterns, picked by splitting the channel range into equal bands
+ */
+class SequenceChannelHandler : public IChannelHandler
+{
+public:
+    /**
+     * @param programs One program per band from PatternPool, nullptr for off, released when the handler is destroyed
+     * @param hysteresis µs the value has to move past a band boundary before the pattern switches
+     */
+    SequenceChannelHandler(PatternScheduler &scheduler, uint8_t pin, PatternProgram *const programs[], uint8_t numPrograms,
+                           uint8_t phaseGroup, uint16_t phaseOffsetMs, uint16_t hysteresis);
+    ~SequenceChannelHandler();
+    void attach() override;
+    void detach() override;
+    void onChannelChange(uint16_t value) override;
+
+private:
+    PatternScheduler &scheduler;
+    PatternProgram *programs[PATTERN_SLOTS];
+    uint8_t numPrograms;
+    uint8_t pin;
+    uint8_t phaseGroup;
+    int8_t outputId; // Output in the scheduler while attached, -1 otherwise
+    int8_t band;     // Band the value was last in, -1 before the first value
+    uint16_t phaseOffsetMs;
+    uint16_t hysteresis;
+};
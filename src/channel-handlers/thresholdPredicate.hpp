@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+enum ThresholdOperator : uint8_t
+{
+    ThresholdOperator_GREATER_THAN,
+    ThresholdOperator_LESS_THAN,
+    ThresholdOperator_EQUALS
+};
+
+/**
+ * @brief Channel comparison compiled from the handler config, evaluated inline
+ *
+ * With a hysteresis the comparison acts as a Schmitt trigger: the output turns
+ * on once the value is hysteresis past the threshold and only turns off again
+ * once it is hysteresis back on the other side, so noise around the threshold
+ * does not make the output chatter. A hysteresis of 0 is a plain comparison.
+ */
+struct ThresholdPredicate
+{
+    ThresholdOperator op;
+    bool state; // Last result, selects the switch point
+    int16_t threshold;
+    int16_t hysteresis;
+
+    ThresholdPredicate(ThresholdOperator op = ThresholdOperator_GREATER_THAN, int16_t threshold = 0, int16_t hysteresis = 0)
+        : op(op), state(false), threshold(threshold), hysteresis(hysteresis) {}
+
+    inline bool evaluate(uint16_t value)
+    {
+        int v = value;
+        int band = state ? -hysteresis : hysteresis;
+
+        switch (op)
+        {
+        case ThresholdOperator_LESS_THAN:
+            state = v < threshold - band;
+            break;
+        case ThresholdOperator_EQUALS:
+            state = abs(v - threshold) <= hysteresis;
+            break;
+        default:
+            state = v > threshold + band;
+            break;
+        }
+        return state;
+    }
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+
+// RC channels received over CRSF, numbered 1..HIGHEST_CHANNEL_NUMBER
+#define HIGHEST_CHANNEL_NUMBER 16
+#define CHANNEL_MIN 1000
+#define CHANNEL_MAX 2000
+#define CHANNEL_MID (CHANNEL_MIN + ((CHANNEL_MAX - CHANNEL_MIN) / 2))
+
+// Virtual channels written by the mixer follow the RC channels
+#define MIXER_CHANNEL_COUNT 32
+#define FIRST_MIXER_CHANNEL (HIGHEST_CHANNEL_NUMBER + 1)
+#define LAST_MIXER_CHANNEL (FIRST_MIXER_CHANNEL + MIXER_CHANNEL_COUNT - 1)
+// Enough for a fully dense matrix of every RC channel into every mixer channel
+#define MIXER_MAX_TERMS (HIGHEST_CHANNEL_NUMBER * MIXER_CHANNEL_COUNT)
+
+// Virtual channels written by logic expressions follow the mixer channels
+#define LOGIC_CHANNEL_COUNT 20
+#define FIRST_LOGIC_CHANNEL (FIRST_MIXER_CHANNEL + MIXER_CHANNEL_COUNT)
+#define LAST_LOGIC_CHANNEL (FIRST_LOGIC_CHANNEL + LOGIC_CHANNEL_COUNT - 1)
+
+// Virtual channels carrying the filtered analog sensors follow the logic channels
+#define SENSOR_CHANNEL_COUNT 4
+#define FIRST_SENSOR_CHANNEL (LAST_LOGIC_CHANNEL + 1)
+
+// Every channel a handler can bind to
+#define CHANNEL_COUNT (HIGHEST_CHANNEL_NUMBER + MIXER_CHANNEL_COUNT + LOGIC_CHANNEL_COUNT + SENSOR_CHANNEL_COUNT)
+
+#define CHANNEL_MASK_WORDS ((CHANNEL_COUNT + 31) / 32)
+
+/**
+ * @brief Set of 0-based channel indices, sized for the whole channel space
+ */
+struct ChannelMask
+{
+    uint32_t words[CHANNEL_MASK_WORDS];
+
+    ChannelMask() { clear(); }
+
+    /**
+     * @brief Mask from a bitfield whose bit n stands for channel index first + n
+     */
+    static ChannelMask fromBits(uint32_t bits, uint8_t first = 0)
+    {
+        ChannelMask mask;
+        for (; bits; bits &= bits - 1)
+        {
+            mask.set(first + __builtin_ctz(bits));
+        }
+        return mask;
+    }
+
+    void clear() { memset(words, 0, sizeof(words)); }
+    void set(uint8_t index) { words[index >> 5] |= 1UL << (index & 31); }
+    bool test(uint8_t index) const { return words[index >> 5] & (1UL << (index & 31)); }
+
+    bool any() const
+    {
+        uint32_t bits = 0;
+        for (int i = 0; i < CHANNEL_MASK_WORDS; i++)
+        {
+            bits |= words[i];
+        }
+        return bits != 0;
+    }
+
+    bool intersects(const ChannelMask &other) const
+    {
+        uint32_t bits = 0;
+        for (int i = 0; i < CHANNEL_MASK_WORDS; i++)
+        {
+            bits |= words[i] & other.words[i];
+        }
+        return bits != 0;
+    }
+
+    ChannelMask &operator|=(const ChannelMask &other)
+    {
+        for (int i = 0; i < CHANNEL_MASK_WORDS; i++)
+        {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+};
@@ -6,6 +6,7 @@ ConfigManager::ConfigManager(BoardComputer *computer, EEPROMManager *eeprom)
     : computer(computer), eeprom(eeprom), config(), eepromInitialized(false)
 {
     eepromInitialized = false;
+    memset(liveHandlers, 0, sizeof(liveHandlers));
 }
 
 bool ConfigManager::begin()
@@ -18,9 +19,8 @@ bool ConfigManager::begin()
         return false;
     }
 
-    // Try to read config, if it fails (checksum error), clear EEPROM
-    Config testConfig;
-    if (!eeprom->read(testConfig))
+    // Check the stored config, if it fails (checksum error), clear EEPROM
+    if (!eeprom->verify())
     {
         LOG.error("ConfigManager", "Invalid data in EEPROM, clearing...");
         eeprom->clear();
@@ -31,7 +31,10 @@ bool ConfigManager::begin()
 
 bool ConfigManager::load(const Config &config)
 {
-    this->configure(config);
+    if (!this->configure(config))
+    {
+        return false; // Keep the running and persisted configuration
+    }
 
     if (!eepromInitialized)
     {
@@ -50,29 +53,51 @@ bool ConfigManager::loadFromEEPROM()
         return false;
     }
 
-    Config config;
-    if (!eeprom->read(config))
+    std::unique_ptr<Config> config = allocateConfig();
+    if (!config)
+    {
+        return false;
+    }
+
+    if (!eeprom->read(*config))
     {
         LOG.error("ConfigManager", "Failed to load config, using defaults");
         return false;
     }
-    return configure(config);
+    return configure(*config);
 }
 
 bool ConfigManager::loadFromJson(const char *jsonConfig)
 {
-    Config config = parseJson(jsonConfig);
-    return load(config);
+    std::unique_ptr<Config> config = allocateConfig();
+    if (!config)
+    {
+        return false;
+    }
+
+    parseJson(jsonConfig, *config);
+    return load(*config);
 }
 
-Config ConfigManager::getConfig()
+std::unique_ptr<Config> ConfigManager::allocateConfig()
+{
+    // On the heap, a Config does not fit the stacks of setup() and the web server
+    std::unique_ptr<Config> config(new (std::nothrow) Config());
+    if (!config)
+    {
+        LOG.errorf("ConfigManager", "Not enough memory for a %d byte config", sizeof(Config));
+    }
+    return config;
+}
+
+const Config &ConfigManager::getConfig() const
 {
     return config;
 }
 
 String ConfigManager::getConfigAsJson()
 {
-    StaticJsonDocument<2048> doc;
+    DynamicJsonDocument doc(CONFIG_JSON_CAPACITY);
     JsonArray handlers = doc.createNestedArray("handlers");
 
     for (size_t i = 0; i < config.numHandlers; i++)
@@ -90,11 +115,129 @@ String ConfigManager::getConfigAsJson()
         handlerObj["max"] = handler.max;
         handlerObj["onTime"] = handler.onTime;
         handlerObj["offTime"] = handler.offTime;
+        handlerObj["failsafeHold"] = handler.failsafeHoldMs;
+        handlerObj["failsafeRamp"] = handler.failsafeRampRate;
+        handlerObj["hysteresis"] = handler.hysteresis;
+        handlerObj["expo"] = handler.expo;
+        handlerObj["endpointLow"] = handler.endpointLow;
+        handlerObj["endpointHigh"] = handler.endpointHigh;
+        handlerObj["subtrim"] = handler.subtrim;
+        handlerObj["slewRate"] = handler.slewRate;
+        handlerObj["filter"] = handler.filterMs;
+        handlerObj["interpolate"] = handler.interpolate;
+        handlerObj["phaseGroup"] = handler.phaseGroup;
+        handlerObj["phaseOffset"] = handler.phaseOffsetMs;
+        handlerObj["frequency"] = handler.frequency;
+        handlerObj["resolution"] = handler.resolution;
+        handlerObj["unit"] = handler.unit == PWMUnit_PERCENT ? "percent" : "us";
+        handlerObj["pin2"] = handler.pin2;
+        handlerObj["deadband"] = handler.deadband;
+        handlerObj["deadTime"] = handler.deadTimeMs;
+        handlerObj["ramp"] = handler.rampMs;
+        handlerObj["failsafeMode"] = handler.failsafeMode == HBridgeStopMode_COAST ? "coast" : "brake";
+        handlerObj["pixels"] = handler.numPixels;
+        char color[8];
+        snprintf(color, sizeof(color), "#%02x%02x%02x", handler.color[0], handler.color[1], handler.color[2]);
+        handlerObj["color"] = color;
+        JsonArray patterns = handlerObj.createNestedArray("patterns");
+        for (uint8_t p = 0; p < handler.numPatterns; p++)
+        {
+            patterns.add(handler.patterns[p]);
+        }
+        JsonArray curve = handlerObj.createNestedArray("curve");
+        for (uint8_t p = 0; p < handler.numCurvePoints; p++)
+        {
+            curve.add(handler.curvePoints[p]);
+        }
     }
 
     doc["apSsid"] = config.apSsid;
     doc["apPassword"] = config.apPassword;
     doc["keepWebServerRunning"] = config.keepWebServerRunning;
+    doc["failsafeFrameGap"] = config.failsafeFrameGapMs;
+    doc["alignOutputCommits"] = config.alignOutputCommits;
+    doc["input"] = inputProtocolName((InputProtocol)config.inputProtocol);
+    doc["failsafeMinLinkQuality"] = config.failsafeMinLinkQuality;
+
+    JsonArray mixer = doc.createNestedArray("mixer");
+    for (size_t i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        if (!(config.mixer.outputs & (1UL << i)))
+        {
+            continue;
+        }
+
+        JsonObject output = mixer.createNestedObject();
+        output["channel"] = FIRST_MIXER_CHANNEL + i;
+        output["offset"] = config.mixer.offsets[i];
+        JsonArray inputs = output.createNestedArray("inputs");
+        for (size_t t = 0; t < config.mixer.numTerms; t++)
+        {
+            const MixerTermConfig &term = config.mixer.terms[t];
+            if (term.output == FIRST_MIXER_CHANNEL + i)
+            {
+                JsonObject input = inputs.createNestedObject();
+                input["channel"] = term.input;
+                input["weight"] = term.weight;
+            }
+        }
+    }
+
+    JsonArray patterns = doc.createNestedArray("patterns");
+    for (size_t i = 0; i < PATTERN_COUNT; i++)
+    {
+        const PatternConfig &pattern = config.patterns[i];
+        if (pattern.numSteps == 0)
+        {
+            continue;
+        }
+
+        JsonObject patternObj = patterns.createNestedObject();
+        patternObj["pattern"] = i + 1;
+        JsonArray steps = patternObj.createNestedArray("steps");
+        for (uint8_t s = 0; s < pattern.numSteps; s++)
+        {
+            JsonObject step = steps.createNestedObject();
+            step["level"] = pattern.steps[s].level;
+            step["ms"] = pattern.steps[s].durationMs;
+            if (pattern.steps[s].fade)
+            {
+                step["fade"] = true;
+            }
+        }
+    }
+
+    JsonArray logic = doc.createNestedArray("logic");
+    for (size_t i = 0; i < config.logic.numExpressions; i++)
+    {
+        JsonObject expression = logic.createNestedObject();
+        expression["channel"] = config.logic.expressions[i].channel;
+        expression["expression"] = config.logic.expressions[i].source;
+    }
+
+    JsonObject telemetry = doc.createNestedObject("telemetry");
+    telemetry["batteryRate"] = config.telemetry.ratesHz[CrsfTelemetryFrame_BATTERY];
+    telemetry["flightModeRate"] = config.telemetry.ratesHz[CrsfTelemetryFrame_FLIGHT_MODE];
+    telemetry["statusRate"] = config.telemetry.ratesHz[CrsfTelemetryFrame_STATUS];
+    telemetry["batteryChannel"] = config.telemetry.batteryChannel;
+    telemetry["batteryRatio"] = config.telemetry.batteryRatio / 100.0f;
+
+    JsonArray sensors = doc.createNestedArray("sensors");
+    for (size_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        const SensorConfig &sensorConfig = config.sensors[i];
+        if (sensorConfig.pin[0] == '\0')
+        {
+            continue;
+        }
+
+        JsonObject sensor = sensors.createNestedObject();
+        sensor["channel"] = FIRST_SENSOR_CHANNEL + i;
+        sensor["pin"] = sensorConfig.pin;
+        sensor["min"] = sensorConfig.minMv;
+        sensor["max"] = sensorConfig.maxMv;
+        sensor["filter"] = sensorConfig.filterMs;
+    }
 
     String output;
     serializeJson(doc, output);
@@ -111,46 +254,151 @@ bool ConfigManager::configure(const Config &config)
         LOG.warning("ConfigManager", "No handlers configured");
     }
 
-    // Clean up old configuration
-    computer->cleanup();
+    SensorInput sensorInputs[SENSOR_CHANNEL_COUNT];
+    if (!createSensorInputs(config, sensorInputs))
+    {
+        LOG.error("ConfigManager", "Sensors are invalid, keeping the running configuration");
+        return false;
+    }
 
-    // Store the new configuration
-    this->config = config;
+    // Build the new handler set next to the running one
+    if (!computer->beginHandlerSet(config.numHandlers))
+    {
+        return false;
+    }
+
+    if (!computer->setMixer(config.mixer))
+    {
+        computer->abortHandlerSet();
+        LOG.error("ConfigManager", "Mixer is invalid, keeping the running configuration");
+        return false;
+    }
+
+    // Expressions are compiled once here, the control task only runs the bytecode
+    for (size_t i = 0; i < config.logic.numExpressions; i++)
+    {
+        const LogicExpressionConfig &expression = config.logic.expressions[i];
+        if (!computer->setLogic(expression.channel, expression.source))
+        {
+            computer->abortHandlerSet();
+            LOG.errorf("ConfigManager", "Logic channel %d is invalid, keeping the running configuration", expression.channel);
+            return false;
+        }
+    }
+
+    IChannelHandler *nextHandlers[Config::MAX_HANDLERS] = {};
+    bool claimed[Config::MAX_HANDLERS] = {};
 
     for (size_t i = 0; i < config.numHandlers; i++)
     {
-        const auto &handler = config.handlers[i];
-        LOG.debugf("ConfigManager", "Configuring %s handler for pin '%s' on channel %d",
-                   handler.type, handler.pin, handler.channel);
+        const auto &handlerConfig = config.handlers[i];
 
-        if (strcmp(handler.type, "pwm") == 0)
+        // Unchanged handlers keep running without being re-initialised
+        IChannelHandler *handler = findLiveHandler(handlerConfig, config.patterns, claimed);
+        bool isNew = handler == nullptr;
+        if (isNew)
         {
-            configurePWMHandler(handler);
+            LOG.debugf("ConfigManager", "Configuring %s handler for pin '%s' on channel %d",
+                       handlerConfig.type, handlerConfig.pin, handlerConfig.channel);
+            handler = createHandler(handlerConfig, config.patterns);
         }
-        else if (strcmp(handler.type, "onoff") == 0)
+
+        if (handler == nullptr || !computer->onChannelChange(handlerConfig.channel, handler, createFailsafeProfile(handlerConfig),
+                                                         createConditioningProfile(handlerConfig)))
         {
-            configureOnOffHandler(handler);
+            if (isNew)
+            {
+                computer->getHandlerArena().destroy(handler);
+            }
+            computer->abortHandlerSet();
+            LOG.errorf("ConfigManager", "Handler %d is invalid, keeping the running configuration", i + 1);
+            return false;
         }
-        else if (strcmp(handler.type, "blink") == 0)
+
+        nextHandlers[i] = handler;
+    }
+
+    computer->setFailsafeBudget(config.failsafeFrameGapMs, config.failsafeMinLinkQuality);
+    computer->setOutputCommitAlignment(config.alignOutputCommits);
+    computer->setTelemetry(config.telemetry.ratesHz, config.telemetry.batteryChannel, config.telemetry.batteryRatio);
+    computer->setInputProtocol((InputProtocol)config.inputProtocol);
+    computer->publishHandlerSet();
+
+    // Restarting the ADC resets the filters, so only do it if the sensors changed
+    if (!std::equal(config.sensors, config.sensors + SENSOR_CHANNEL_COUNT, this->config.sensors) &&
+        !computer->getAdcSampler().configure(sensorInputs))
+    {
+        LOG.error("ConfigManager", "Sensors could not be started, their channels keep their last values");
+    }
+
+    // Store the new configuration
+    this->config = config;
+    memcpy(liveHandlers, nextHandlers, sizeof(liveHandlers));
+
+    LOG.info("ConfigManager", "Configuration complete!");
+    return true;
+}
+
+IChannelHandler *ConfigManager::findLiveHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[], bool claimed[])
+{
+    // A sequence also has to keep running the same patterns
+    for (uint8_t p = 0; p < handlerConfig.numPatterns; p++)
+    {
+        uint8_t number = handlerConfig.patterns[p];
+        if (number > 0 && number <= PATTERN_COUNT && config.patterns[number - 1] != patterns[number - 1])
         {
-            configureBlinkHandler(handler);
+            return nullptr;
         }
-        else
+    }
+
+    for (size_t i = 0; i < config.numHandlers; i++)
+    {
+        if (!claimed[i] && liveHandlers[i] != nullptr && config.handlers[i].sameAs(handlerConfig))
         {
-            LOG.warningf("ConfigManager", "Unknown handler type '%s'", handler.type);
+            claimed[i] = true;
+            return liveHandlers[i];
         }
     }
+    return nullptr;
+}
 
-    LOG.info("ConfigManager", "Configuration complete!");
-    return true;
+IChannelHandler *ConfigManager::createHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[])
+{
+    if (strcmp(handlerConfig.type, "pwm") == 0)
+    {
+        return configurePWMHandler(handlerConfig);
+    }
+    else if (strcmp(handlerConfig.type, "onoff") == 0)
+    {
+        return configureOnOffHandler(handlerConfig);
+    }
+    else if (strcmp(handlerConfig.type, "blink") == 0)
+    {
+        return configureBlinkHandler(handlerConfig);
+    }
+    else if (strcmp(handlerConfig.type, "sequence") == 0)
+    {
+        return configureSequenceHandler(handlerConfig, patterns);
+    }
+    else if (strcmp(handlerConfig.type, "hbridge") == 0)
+    {
+        return configureHBridgeHandler(handlerConfig);
+    }
+    else if (strcmp(handlerConfig.type, "lightbar") == 0)
+    {
+        return configureLightBarHandler(handlerConfig, patterns);
+    }
+
+    LOG.warningf("ConfigManager", "Unknown handler type '%s'", handlerConfig.type);
+    return nullptr;
 }
 
-void ConfigManager::configurePWMHandler(const HandlerConfig &handlerConfig)
+IChannelHandler *ConfigManager::configurePWMHandler(const HandlerConfig &handlerConfig)
 {
     if (!handlerConfig.failsafe)
     {
         LOG.error("ConfigManager", "PWM handler requires 'failsafe' value");
-        return;
+        return nullptr;
     }
 
     auto pinInfo = PIN_MAP.find(handlerConfig.pin);
@@ -158,7 +406,7 @@ void ConfigManager::configurePWMHandler(const HandlerConfig &handlerConfig)
     {
         LOG.errorf("ConfigManager", "Invalid PWM pin: %s (isPWM: %s)",
                    handlerConfig.pin, pinInfo == PIN_MAP.end() ? "unknown" : (pinInfo->second.isPWM ? "yes" : "no"));
-        return;
+        return nullptr;
     }
 
     uint8_t channel = handlerConfig.channel;
@@ -172,10 +420,10 @@ void ConfigManager::configurePWMHandler(const HandlerConfig &handlerConfig)
                channel, handlerConfig.pin, pinInfo->second.pin);
 
     // Validate channel number
-    if (channel < 1 || channel > HIGHEST_CHANNEL_NUMBER)
+    if (channel < 1 || channel > CHANNEL_COUNT)
     {
         LOG.errorf("ConfigManager", "Invalid channel number: %d", channel);
-        return;
+        return nullptr;
     }
 
     // Validate failsafe value is within range
@@ -183,57 +431,85 @@ void ConfigManager::configurePWMHandler(const HandlerConfig &handlerConfig)
     {
         LOG.errorf("ConfigManager", "Failsafe value %d is out of range (%d-%d)",
                    failsafeValue, CHANNEL_MIN, CHANNEL_MAX);
-        return;
+        return nullptr;
     }
 
     // Validate min/max values
     if (min >= max)
     {
         LOG.errorf("ConfigManager", "Invalid PWM range: min (%d) must be less than max (%d)", min, max);
-        return;
+        return nullptr;
     }
 
-    LOG.debugf("ConfigManager", "PWM Config: Pin=%s(GPIO%d), Channel=%d, Failsafe=%d, Range=%d-%d, Inverted=%s",
-               handlerConfig.pin, pinInfo->second.pin, channel, failsafeValue, min, max, inverted ? "yes" : "no");
+    PWMUnit unit = handlerConfig.unit == PWMUnit_PERCENT ? PWMUnit_PERCENT : PWMUnit_MICROSECONDS;
+    if (unit == PWMUnit_PERCENT && (min < 0 || max > 100))
+    {
+        LOG.errorf("ConfigManager", "Invalid PWM range: %d-%d%% is outside 0-100%%", min, max);
+        return nullptr;
+    }
 
-    auto *handler = new PWMChannelHandler(pinInfo->second.pin, min, max);
-    handler->setup(failsafeValue); // Use failsafe as initial value
-    handler->setInverted(inverted);
+    LOG.debugf("ConfigManager", "PWM Config: Pin=%s(GPIO%d), Channel=%d, Failsafe=%d, Range=%d-%d%s, %dHz/%d bits, Inverted=%s, Expo=%d, Endpoints=%d/%d%%, Subtrim=%d, Curve points=%d",
+               handlerConfig.pin, pinInfo->second.pin, channel, failsafeValue, min, max, unit == PWMUnit_PERCENT ? "%" : "us",
+               handlerConfig.frequency, handlerConfig.resolution, inverted ? "yes" : "no",
+               handlerConfig.expo, handlerConfig.endpointLow, handlerConfig.endpointHigh, handlerConfig.subtrim,
+               handlerConfig.numCurvePoints);
 
-    LOG.debugf("ConfigManager", "Registering PWM handler for channel %d", channel);
-    this->computer->onChannelChange(channel, handler, failsafeValue);
+    // Outputs with the same curve share one table. Percent outputs scale to the duty
+    // range themselves, their curve stays in the channel range.
+    CurveParams params = createCurveParams(handlerConfig);
+    if (unit == PWMUnit_PERCENT)
+    {
+        params.min = CHANNEL_MIN;
+        params.max = CHANNEL_MAX;
+    }
+    ResponseCurve *curve = curvePool.acquire(params);
+    if (curve == nullptr)
+    {
+        return nullptr;
+    }
 
-    LOG.debug("ConfigManager", "PWM handler registration complete");
+    auto *handler = computer->getHandlerArena().create<PWMChannelHandler>(computer->getLedcDriver(), computer->getOutputShadow(),
+                                                                          pinInfo->second.pin, curve,
+                                                                          handlerConfig.frequency, handlerConfig.resolution,
+                                                                          unit, min, max);
+    if (handler == nullptr)
+    {
+        curve->release();
+        return nullptr;
+    }
+    handler->setup(failsafeValue); // Use failsafe as initial value
+
+    return handler;
 }
 
-void ConfigManager::configureOnOffHandler(const HandlerConfig &handlerConfig)
+IChannelHandler *ConfigManager::configureOnOffHandler(const HandlerConfig &handlerConfig)
 {
     if (!handlerConfig.failsafe)
     {
         LOG.error("ConfigManager", "OnOff handler requires 'failsafe' value");
-        return;
+        return nullptr;
     }
 
     auto pinInfo = PIN_MAP.find(handlerConfig.pin);
     if (pinInfo == PIN_MAP.end())
     {
         LOG.errorf("ConfigManager", "Invalid pin: %s", handlerConfig.pin);
-        return;
+        return nullptr;
     }
 
     uint8_t channel = handlerConfig.channel;
     int failsafeValue = handlerConfig.failsafe;
-    auto compareFunc = createThresholdFunction(handlerConfig);
+    ThresholdPredicate predicate = createThresholdPredicate(handlerConfig);
 
     // Add detailed debug logging
     LOG.debugf("ConfigManager", "Configuring OnOff handler - Channel: %d, Pin: %s (GPIO%d)",
                channel, handlerConfig.pin, pinInfo->second.pin);
 
     // Validate channel number
-    if (channel < 1 || channel > HIGHEST_CHANNEL_NUMBER)
+    if (channel < 1 || channel > CHANNEL_COUNT)
     {
         LOG.errorf("ConfigManager", "Invalid channel number: %d", channel);
-        return;
+        return nullptr;
     }
 
     // Validate failsafe value is within range
@@ -241,98 +517,368 @@ void ConfigManager::configureOnOffHandler(const HandlerConfig &handlerConfig)
     {
         LOG.errorf("ConfigManager", "Failsafe value %d is out of range (%d-%d)",
                    failsafeValue, CHANNEL_MIN, CHANNEL_MAX);
-        return;
+        return nullptr;
     }
 
-    LOG.debugf("ConfigManager", "OnOff Config: Pin=%s(GPIO%d), Failsafe=%d, Threshold=%d, Operator=%s",
-               handlerConfig.pin, pinInfo->second.pin, failsafeValue, handlerConfig.threshold, handlerConfig.op);
+    LOG.debugf("ConfigManager", "OnOff Config: Pin=%s(GPIO%d), Failsafe=%d, Threshold=%d, Operator=%s, Hysteresis=%d",
+               handlerConfig.pin, pinInfo->second.pin, failsafeValue, handlerConfig.threshold, handlerConfig.op, handlerConfig.hysteresis);
 
-    auto *handler = new OnOffChannelHandler(pinInfo->second.pin);
-    handler->isOnWhen(compareFunc);
-    this->computer->onChannelChange(channel, handler, failsafeValue);
-
-    LOG.debug("ConfigManager", "Handler registration complete");
+    auto *handler = computer->getHandlerArena().create<OnOffChannelHandler>(computer->getOutputShadow(), pinInfo->second.pin);
+    if (handler == nullptr)
+    {
+        return nullptr;
+    }
+    handler->isOnWhen(predicate);
+    return handler;
 }
 
-void ConfigManager::configureBlinkHandler(const HandlerConfig &handlerConfig)
+IChannelHandler *ConfigManager::configureBlinkHandler(const HandlerConfig &handlerConfig)
 {
     if (!handlerConfig.failsafe)
     {
         LOG.error("ConfigManager", "Blink handler requires 'failsafe' value");
-        return;
+        return nullptr;
     }
 
     auto pinInfo = PIN_MAP.find(handlerConfig.pin);
     if (pinInfo == PIN_MAP.end())
     {
         LOG.errorf("ConfigManager", "Invalid pin: %s", handlerConfig.pin);
-        return;
+        return nullptr;
     }
 
     uint8_t channel = handlerConfig.channel;
     int failsafeValue = handlerConfig.failsafe;
     int onTime = handlerConfig.onTime;
     int offTime = handlerConfig.offTime;
-    auto compareFunc = createThresholdFunction(handlerConfig);
+    ThresholdPredicate predicate = createThresholdPredicate(handlerConfig);
 
     // Validate failsafe value is within range
     if (failsafeValue < CHANNEL_MIN || failsafeValue > CHANNEL_MAX)
     {
         LOG.errorf("ConfigManager", "Failsafe value %d is out of range (%d-%d)",
                    failsafeValue, CHANNEL_MIN, CHANNEL_MAX);
-        return;
+        return nullptr;
     }
 
-    LOG.debugf("ConfigManager", "Blink Config: Pin=%s(GPIO%d), Failsafe=%d, Timing=%dms on, %dms off, Threshold=%d, Operator=%s",
-               handlerConfig.pin, pinInfo->second.pin, failsafeValue, onTime, offTime, handlerConfig.threshold, handlerConfig.op);
+    LOG.debugf("ConfigManager", "Blink Config: Pin=%s(GPIO%d), Failsafe=%d, Timing=%dms on, %dms off, Phase group=%d, Threshold=%d, Operator=%s, Hysteresis=%d",
+               handlerConfig.pin, pinInfo->second.pin, failsafeValue, onTime, offTime, handlerConfig.phaseGroup,
+               handlerConfig.threshold, handlerConfig.op, handlerConfig.hysteresis);
+
+    // Outputs blinking with the same timing share one program
+    PatternProgram *program = patternPool.acquire(PatternConfig::blink(onTime, offTime));
+    if (program == nullptr)
+    {
+        return nullptr;
+    }
 
-    auto *handler = new BlinkChannelHandler(pinInfo->second.pin, onTime, offTime);
-    handler->isOnWhen(compareFunc);
-    this->computer->onChannelChange(channel, handler, failsafeValue);
+    auto *handler = computer->getHandlerArena().create<BlinkChannelHandler>(computer->getPatternScheduler(), pinInfo->second.pin,
+                                                                            program, handlerConfig.phaseGroup);
+    if (handler == nullptr)
+    {
+        program->release();
+        return nullptr;
+    }
+    handler->isOnWhen(predicate);
+    return handler;
 }
 
-auto ConfigManager::createThresholdFunction(const HandlerConfig &handlerConfig) -> std::function<bool(uint16_t)>
+IChannelHandler *ConfigManager::configureSequenceHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[])
 {
-    int threshold = handlerConfig.threshold;
-    const char *op = handlerConfig.op;
+    if (!handlerConfig.failsafe)
+    {
+        LOG.error("ConfigManager", "Sequence handler requires 'failsafe' value");
+        return nullptr;
+    }
+
+    auto pinInfo = PIN_MAP.find(handlerConfig.pin);
+    if (pinInfo == PIN_MAP.end())
+    {
+        LOG.errorf("ConfigManager", "Invalid pin: %s", handlerConfig.pin);
+        return nullptr;
+    }
+
+    int failsafeValue = handlerConfig.failsafe;
+    if (failsafeValue < CHANNEL_MIN || failsafeValue > CHANNEL_MAX)
+    {
+        LOG.errorf("ConfigManager", "Failsafe value %d is out of range (%d-%d)",
+                   failsafeValue, CHANNEL_MIN, CHANNEL_MAX);
+        return nullptr;
+    }
+
+    if (handlerConfig.numPatterns == 0 || handlerConfig.numPatterns > PATTERN_SLOTS)
+    {
+        LOG.errorf("ConfigManager", "Sequence handler needs 1-%d patterns, got %d", PATTERN_SLOTS, handlerConfig.numPatterns);
+        return nullptr;
+    }
+
+    PatternProgram *programs[PATTERN_SLOTS] = {};
+    bool valid = acquirePatternPrograms(handlerConfig, patterns, programs);
+
+    LOG.debugf("ConfigManager", "Sequence Config: Pin=%s(GPIO%d), Failsafe=%d, Patterns=%d/%d/%d/%d, Phase group=%d, Offset=%dms, Hysteresis=%d",
+               handlerConfig.pin, pinInfo->second.pin, failsafeValue, handlerConfig.patterns[0], handlerConfig.patterns[1],
+               handlerConfig.patterns[2], handlerConfig.patterns[3], handlerConfig.phaseGroup, handlerConfig.phaseOffsetMs,
+               handlerConfig.hysteresis);
+
+    SequenceChannelHandler *handler = nullptr;
+    if (valid)
+    {
+        handler = computer->getHandlerArena().create<SequenceChannelHandler>(
+            computer->getPatternScheduler(), pinInfo->second.pin, programs, handlerConfig.numPatterns,
+            handlerConfig.phaseGroup, handlerConfig.phaseOffsetMs, constrain(handlerConfig.hysteresis, 0, CHANNEL_MAX - CHANNEL_MIN));
+    }
 
-    std::function<bool(uint16_t)> compareFunc;
+    if (handler == nullptr)
+    {
+        releasePatternPrograms(programs);
+        return nullptr;
+    }
+
+    LOG.debugf("ConfigManager", "%d of %d pattern programs in use, %d bytes each", patternPool.used(), PATTERN_POOL_SIZE,
+               sizeof(PatternProgram));
+    return handler;
+}
+
+IChannelHandler *ConfigManager::configureLightBarHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[])
+{
+    auto pinInfo = PIN_MAP.find(handlerConfig.pin);
+    if (pinInfo == PIN_MAP.end())
+    {
+        LOG.errorf("ConfigManager", "Invalid pin: %s", handlerConfig.pin);
+        return nullptr;
+    }
+
+    uint8_t channel = handlerConfig.channel;
+    if (channel < 1 || channel > CHANNEL_COUNT)
+    {
+        LOG.errorf("ConfigManager", "Invalid channel number: %d", channel);
+        return nullptr;
+    }
+
+    if (handlerConfig.numPixels == 0 || handlerConfig.numPixels > WS2812_MAX_PIXELS)
+    {
+        LOG.errorf("ConfigManager", "Light bar needs 1-%d pixels, got %d", WS2812_MAX_PIXELS, handlerConfig.numPixels);
+        return nullptr;
+    }
+
+    // No patterns makes the bar a bar graph of the channel
+    PatternProgram *programs[PATTERN_SLOTS] = {};
+    if (!acquirePatternPrograms(handlerConfig, patterns, programs))
+    {
+        releasePatternPrograms(programs);
+        return nullptr;
+    }
+
+    uint32_t color = (uint32_t)handlerConfig.color[0] << 16 | (uint32_t)handlerConfig.color[1] << 8 | handlerConfig.color[2];
+    LOG.debugf("ConfigManager", "Light bar Config: Pin=%s(GPIO%d), Channel=%d, Pixels=%d, Color=#%06lx, Inverted=%s, Patterns=%d/%d/%d/%d, Pixel offset=%dms",
+               handlerConfig.pin, pinInfo->second.pin, channel, handlerConfig.numPixels, color,
+               handlerConfig.inverted ? "yes" : "no", handlerConfig.patterns[0], handlerConfig.patterns[1],
+               handlerConfig.patterns[2], handlerConfig.patterns[3], handlerConfig.phaseOffsetMs);
+
+    auto *handler = computer->getHandlerArena().create<LightBarChannelHandler>(
+        computer->getWs2812Driver(), pinInfo->second.pin, handlerConfig.numPixels, color, handlerConfig.inverted,
+        programs, handlerConfig.numPatterns, handlerConfig.phaseOffsetMs,
+        constrain(handlerConfig.hysteresis, 0, CHANNEL_MAX - CHANNEL_MIN));
+    if (handler == nullptr)
+    {
+        releasePatternPrograms(programs);
+    }
+    return handler;
+}
+
+bool ConfigManager::acquirePatternPrograms(const HandlerConfig &handlerConfig, const PatternConfig patterns[],
+                                           PatternProgram *programs[])
+{
+    // Same patterns on several outputs share their programs
+    for (uint8_t i = 0; i < handlerConfig.numPatterns && i < PATTERN_SLOTS; i++)
+    {
+        uint8_t number = handlerConfig.patterns[i];
+        if (number == 0)
+        {
+            continue;
+        }
+        if (number > PATTERN_COUNT)
+        {
+            LOG.errorf("ConfigManager", "Pattern %d does not exist (1-%d)", number, PATTERN_COUNT);
+            return false;
+        }
+        programs[i] = patternPool.acquire(patterns[number - 1]);
+        if (programs[i] == nullptr)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ConfigManager::releasePatternPrograms(PatternProgram *programs[])
+{
+    for (uint8_t i = 0; i < PATTERN_SLOTS; i++)
+    {
+        if (programs[i] != nullptr)
+        {
+            programs[i]->release();
+            programs[i] = nullptr;
+        }
+    }
+}
 
+IChannelHandler *ConfigManager::configureHBridgeHandler(const HandlerConfig &handlerConfig)
+{
+    auto pinA = PIN_MAP.find(handlerConfig.pin);
+    auto pinB = PIN_MAP.find(handlerConfig.pin2);
+    if (pinA == PIN_MAP.end() || !pinA->second.isPWM || pinB == PIN_MAP.end() || !pinB->second.isPWM)
+    {
+        LOG.errorf("ConfigManager", "Invalid or non-PWM H-bridge pins: %s/%s", handlerConfig.pin, handlerConfig.pin2);
+        return nullptr;
+    }
+    if (pinA->second.pin == pinB->second.pin)
+    {
+        LOG.errorf("ConfigManager", "H-bridge needs two different pins, got %s twice", handlerConfig.pin);
+        return nullptr;
+    }
+
+    uint8_t channel = handlerConfig.channel;
+    if (channel < 1 || channel > CHANNEL_COUNT)
+    {
+        LOG.errorf("ConfigManager", "Invalid channel number: %d", channel);
+        return nullptr;
+    }
+
+    if (handlerConfig.deadband >= CHANNEL_MAX - CHANNEL_MID)
+    {
+        LOG.errorf("ConfigManager", "Deadband %dus leaves no range to drive the motor", handlerConfig.deadband);
+        return nullptr;
+    }
+
+    HBridgeStopMode failsafeMode = handlerConfig.failsafeMode == HBridgeStopMode_COAST ? HBridgeStopMode_COAST : HBridgeStopMode_BRAKE;
+    LOG.debugf("ConfigManager", "H-bridge Config: Pins=%s(GPIO%d)/%s(GPIO%d), Channel=%d, %dHz/%d bits, Inverted=%s, Deadband=%dus, Dead-time=%dms, Ramp=%dms, Failsafe=%s",
+               handlerConfig.pin, pinA->second.pin, handlerConfig.pin2, pinB->second.pin, channel,
+               handlerConfig.frequency, handlerConfig.resolution, handlerConfig.inverted ? "yes" : "no",
+               handlerConfig.deadband, handlerConfig.deadTimeMs, handlerConfig.rampMs,
+               failsafeMode == HBridgeStopMode_BRAKE ? "brake" : "coast");
+
+    return computer->getHandlerArena().create<HBridgeChannelHandler>(
+        computer->getLedcDriver(), computer->getOutputShadow(), pinA->second.pin, pinB->second.pin,
+        handlerConfig.frequency, handlerConfig.resolution, handlerConfig.inverted, handlerConfig.deadband,
+        handlerConfig.deadTimeMs, handlerConfig.rampMs, failsafeMode);
+}
+
+CurveParams ConfigManager::createCurveParams(const HandlerConfig &handlerConfig)
+{
+    CurveParams params;
+    params.min = handlerConfig.min;
+    params.max = handlerConfig.max;
+    params.reverse = handlerConfig.inverted;
+    params.expo = constrain(handlerConfig.expo, -100, 100);
+    params.endpointLow = constrain(handlerConfig.endpointLow, 0, 150);
+    params.endpointHigh = constrain(handlerConfig.endpointHigh, 0, 150);
+    params.subtrim = constrain(handlerConfig.subtrim, -(CHANNEL_MAX - CHANNEL_MIN) / 2, (CHANNEL_MAX - CHANNEL_MIN) / 2);
+
+    // A single point is not a curve
+    params.numPoints = handlerConfig.numCurvePoints >= 2 ? min(handlerConfig.numCurvePoints, (uint8_t)CURVE_MAX_POINTS) : 0;
+    for (uint8_t i = 0; i < params.numPoints; i++)
+    {
+        params.points[i] = constrain(handlerConfig.curvePoints[i], -100, 100);
+    }
+    return params;
+}
+
+ConditioningProfile ConfigManager::createConditioningProfile(const HandlerConfig &handlerConfig)
+{
+    ConditioningProfile profile;
+    profile.slewRate = constrain(handlerConfig.slewRate, 0, UINT16_MAX);
+    profile.filterMs = constrain(handlerConfig.filterMs, 0, CONDITIONER_MAX_FILTER_MS);
+    profile.interpolate = handlerConfig.interpolate;
+    return profile;
+}
+
+bool ConfigManager::createSensorInputs(const Config &config, SensorInput inputs[])
+{
+    for (size_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        const SensorConfig &sensorConfig = config.sensors[i];
+        inputs[i] = SensorInput();
+        if (sensorConfig.pin[0] == '\0')
+        {
+            continue;
+        }
+
+        auto pinInfo = PIN_MAP.find(sensorConfig.pin);
+        if (pinInfo == PIN_MAP.end() || !pinInfo->second.isADC)
+        {
+            LOG.errorf("ConfigManager", "Sensor on channel %d: %s is not an analog pin", FIRST_SENSOR_CHANNEL + i, sensorConfig.pin);
+            return false;
+        }
+        if (sensorConfig.minMv == sensorConfig.maxMv)
+        {
+            LOG.errorf("ConfigManager", "Sensor on channel %d needs different voltages for min and max", FIRST_SENSOR_CHANNEL + i);
+            return false;
+        }
+
+        // A pin is either an output or a sensor
+        for (size_t h = 0; h < config.numHandlers; h++)
+        {
+            if (strcmp(config.handlers[h].pin, sensorConfig.pin) == 0 || strcmp(config.handlers[h].pin2, sensorConfig.pin) == 0)
+            {
+                LOG.errorf("ConfigManager", "Sensor on channel %d: %s is used by handler %d", FIRST_SENSOR_CHANNEL + i, sensorConfig.pin, h + 1);
+                return false;
+            }
+        }
+
+        inputs[i].used = true;
+        inputs[i].pin = pinInfo->second.pin;
+        inputs[i].minMv = sensorConfig.minMv;
+        inputs[i].maxMv = sensorConfig.maxMv;
+        inputs[i].filterMs = sensorConfig.filterMs;
+        LOG.debugf("ConfigManager", "Sensor Config: Channel=%d, Pin=%s(GPIO%d), %d-%dmV, Filter=%dms", FIRST_SENSOR_CHANNEL + i,
+                   sensorConfig.pin, inputs[i].pin, sensorConfig.minMv, sensorConfig.maxMv, sensorConfig.filterMs);
+    }
+    return true;
+}
+
+FailsafeProfile ConfigManager::createFailsafeProfile(const HandlerConfig &handlerConfig)
+{
+    FailsafeProfile profile;
+    profile.value = handlerConfig.failsafe;
+    profile.holdMs = constrain(handlerConfig.failsafeHoldMs, 0, UINT16_MAX);
+    profile.rampRate = constrain(handlerConfig.failsafeRampRate, 0, UINT16_MAX);
+    return profile;
+}
+
+ThresholdPredicate ConfigManager::createThresholdPredicate(const HandlerConfig &handlerConfig)
+{
+    const char *op = handlerConfig.op;
+    int16_t threshold = constrain(handlerConfig.threshold, CHANNEL_MIN, CHANNEL_MAX);
+    int16_t hysteresis = constrain(handlerConfig.hysteresis, 0, CHANNEL_MAX - CHANNEL_MIN);
+
+    // Resolve the operator once here instead of on every dispatch
     if (strcmp(op, "lessThan") == 0)
     {
-        compareFunc = [threshold](uint16_t value)
-        { return value < threshold; };
+        return ThresholdPredicate(ThresholdOperator_LESS_THAN, threshold, hysteresis);
     }
     else if (strcmp(op, "greaterThan") == 0)
     {
-        compareFunc = [threshold](uint16_t value)
-        { return value > threshold; };
+        return ThresholdPredicate(ThresholdOperator_GREATER_THAN, threshold, hysteresis);
     }
     else if (strcmp(op, "equals") == 0)
     {
-        compareFunc = [threshold](uint16_t value)
-        { return value == threshold; };
-    }
-    else
-    {
-        LOG.warningf("ConfigManager", "Unknown operator '%s', defaulting to greaterThan", op);
-        compareFunc = [threshold](uint16_t value)
-        { return value > threshold; };
+        return ThresholdPredicate(ThresholdOperator_EQUALS, threshold, hysteresis);
     }
 
-    return compareFunc;
+    LOG.warningf("ConfigManager", "Unknown operator '%s', defaulting to greaterThan", op);
+    return ThresholdPredicate(ThresholdOperator_GREATER_THAN, threshold, hysteresis);
 }
 
-Config ConfigManager::parseJson(const char *jsonConfig)
+void ConfigManager::parseJson(const char *jsonConfig, Config &config)
 {
-    Config config;
-    StaticJsonDocument<2048> doc;
+    DynamicJsonDocument doc(CONFIG_JSON_CAPACITY);
     DeserializationError error = deserializeJson(doc, jsonConfig);
 
     if (error)
     {
         LOG.errorf("ConfigManager", "JSON parsing failed: %s", error.c_str());
-        return config;
+        return; // Leaves the defaults
     }
 
     LOG.infof("ConfigManager", "JSON parsed successfully");
@@ -355,13 +901,178 @@ Config ConfigManager::parseJson(const char *jsonConfig)
         handlerConfig.inverted = handler["inverted"] | false;
         handlerConfig.min = handler["min"] | 0;
         handlerConfig.max = handler["max"] | 255;
-        handlerConfig.onTime = handler["onTime"] | 300;
-        handlerConfig.offTime = handler["offTime"] | 400;
+        handlerConfig.onTime = constrain(handler["onTime"] | 300, 0, UINT16_MAX);
+        handlerConfig.offTime = constrain(handler["offTime"] | 400, 0, UINT16_MAX);
+        handlerConfig.failsafeHoldMs = handler["failsafeHold"] | 0;
+        handlerConfig.failsafeRampRate = handler["failsafeRamp"] | 0;
+        handlerConfig.hysteresis = handler["hysteresis"] | 0;
+        handlerConfig.expo = handler["expo"] | 0;
+        handlerConfig.endpointLow = handler["endpointLow"] | 100;
+        handlerConfig.endpointHigh = handler["endpointHigh"] | 100;
+        handlerConfig.subtrim = handler["subtrim"] | 0;
+        handlerConfig.slewRate = handler["slewRate"] | 0;
+        handlerConfig.filterMs = handler["filter"] | 0;
+        handlerConfig.interpolate = handler["interpolate"] | false;
+        handlerConfig.phaseGroup = constrain(handler["phaseGroup"] | 0, 0, PATTERN_PHASE_GROUPS - 1);
+        handlerConfig.phaseOffsetMs = constrain(handler["phaseOffset"] | 0, 0, UINT16_MAX);
+        // Motors run far above servo rates
+        bool isHBridge = strcmp(handlerConfig.type, "hbridge") == 0;
+        handlerConfig.frequency = constrain(handler["frequency"] | (isHBridge ? HBRIDGE_DEFAULT_FREQUENCY : PWM_DEFAULT_FREQUENCY), 0, UINT16_MAX);
+        handlerConfig.resolution = constrain(handler["resolution"] | (isHBridge ? HBRIDGE_DEFAULT_RESOLUTION : PWM_DEFAULT_RESOLUTION), 0, UINT8_MAX);
+        handlerConfig.unit = strcmp(handler["unit"] | "us", "percent") == 0 ? PWMUnit_PERCENT : PWMUnit_MICROSECONDS;
+        handlerConfig.setPin2(handler["pin2"] | "");
+        handlerConfig.deadband = constrain(handler["deadband"] | 20, 0, UINT16_MAX);
+        handlerConfig.deadTimeMs = constrain(handler["deadTime"] | 50, 0, UINT16_MAX);
+        handlerConfig.rampMs = constrain(handler["ramp"] | 500, 0, UINT16_MAX);
+        handlerConfig.failsafeMode = strcmp(handler["failsafeMode"] | "brake", "coast") == 0 ? HBridgeStopMode_COAST : HBridgeStopMode_BRAKE;
+        handlerConfig.numPixels = constrain(handler["pixels"] | 0, 0, WS2812_MAX_PIXELS);
+        const char *color = handler["color"] | "#ffffff";
+        uint32_t rgb = strtoul(color[0] == '#' ? color + 1 : color, nullptr, 16);
+        handlerConfig.color[0] = rgb >> 16;
+        handlerConfig.color[1] = rgb >> 8;
+        handlerConfig.color[2] = rgb;
+
+        JsonArray patterns = handler["patterns"];
+        handlerConfig.numPatterns = std::min(patterns.size(), static_cast<size_t>(PATTERN_SLOTS));
+        for (uint8_t p = 0; p < handlerConfig.numPatterns; p++)
+        {
+            handlerConfig.patterns[p] = constrain(patterns[p] | 0, 0, PATTERN_COUNT);
+        }
+
+        JsonArray curve = handler["curve"];
+        handlerConfig.numCurvePoints = std::min(curve.size(), static_cast<size_t>(CURVE_MAX_POINTS));
+        for (uint8_t p = 0; p < handlerConfig.numCurvePoints; p++)
+        {
+            handlerConfig.curvePoints[p] = constrain(curve[p] | 0, -100, 100);
+        }
     }
 
     strncpy(config.apSsid, doc["apSsid"] | "Bordcomputer", sizeof(config.apSsid));
     strncpy(config.apPassword, doc["apPassword"] | "bordcomputer", sizeof(config.apPassword));
     config.keepWebServerRunning = doc["keepWebServerRunning"] | false;
+    config.failsafeFrameGapMs = constrain(doc["failsafeFrameGap"] | FAILSAFE_FRAME_GAP_MS, 10, 5000);
+    config.alignOutputCommits = doc["alignOutputCommits"] | false;
+    InputProtocol inputProtocol = inputProtocolFromName(doc["input"] | "crsf");
+    if (inputProtocol == InputProtocol_COUNT)
+    {
+        LOG.warningf("ConfigManager", "Unknown input protocol %s, using CRSF", doc["input"] | "");
+        inputProtocol = InputProtocol_CRSF;
+    }
+    config.inputProtocol = inputProtocol;
+    config.failsafeMinLinkQuality = constrain(doc["failsafeMinLinkQuality"] | 0, 0, 100);
 
-    return config;
+    // Mixer outputs with their weighted inputs, validated when the mixer is loaded
+    for (JsonObject output : doc["mixer"].as<JsonArray>())
+    {
+        int channel = output["channel"] | 0;
+        if (channel < FIRST_MIXER_CHANNEL || channel > LAST_MIXER_CHANNEL)
+        {
+            LOG.warningf("ConfigManager", "Ignoring mixer output on channel %d", channel);
+            continue;
+        }
+
+        uint8_t row = channel - FIRST_MIXER_CHANNEL;
+        config.mixer.outputs |= 1UL << row;
+        config.mixer.offsets[row] = output["offset"] | 0;
+
+        for (JsonObject input : output["inputs"].as<JsonArray>())
+        {
+            if (config.mixer.numTerms >= MixerConfig::MAX_TERMS)
+            {
+                LOG.warningf("ConfigManager", "More than %d mixer inputs, ignoring the rest", MixerConfig::MAX_TERMS);
+                break;
+            }
+
+            MixerTermConfig &term = config.mixer.terms[config.mixer.numTerms++];
+            term.input = input["channel"] | 0;
+            term.output = channel;
+            term.weight = constrain(input["weight"] | 100, -MIXER_MAX_WEIGHT_PERCENT, MIXER_MAX_WEIGHT_PERCENT);
+        }
+    }
+
+    // Light patterns, compiled when a sequence handler uses them
+    for (JsonObject pattern : doc["patterns"].as<JsonArray>())
+    {
+        int number = pattern["pattern"] | 0;
+        if (number < 1 || number > PATTERN_COUNT)
+        {
+            LOG.warningf("ConfigManager", "Ignoring pattern %d", number);
+            continue;
+        }
+
+        PatternConfig &patternConfig = config.patterns[number - 1];
+        JsonArray steps = pattern["steps"];
+        patternConfig.numSteps = std::min(steps.size(), static_cast<size_t>(PATTERN_MAX_STEPS));
+        for (uint8_t s = 0; s < patternConfig.numSteps; s++)
+        {
+            patternConfig.steps[s].level = constrain(steps[s]["level"] | 0, 0, 255);
+            patternConfig.steps[s].durationMs = constrain(steps[s]["ms"] | 0, 0, UINT16_MAX);
+            patternConfig.steps[s].fade = steps[s]["fade"] | false;
+        }
+    }
+
+    // Logic expressions, compiled when the config is applied
+    for (JsonObject expression : doc["logic"].as<JsonArray>())
+    {
+        int channel = expression["channel"] | 0;
+        if (channel < FIRST_LOGIC_CHANNEL || channel > LAST_LOGIC_CHANNEL)
+        {
+            LOG.warningf("ConfigManager", "Ignoring logic expression on channel %d", channel);
+            continue;
+        }
+
+        const char *source = expression["expression"] | "";
+        if (strlen(source) >= LOGIC_MAX_EXPRESSION)
+        {
+            LOG.warningf("ConfigManager", "Logic expression on channel %d longer than %d characters, ignoring it",
+                         channel, LOGIC_MAX_EXPRESSION - 1);
+            continue;
+        }
+
+        // A later expression for the same channel replaces the earlier one
+        size_t index = 0;
+        while (index < config.logic.numExpressions && config.logic.expressions[index].channel != channel)
+        {
+            index++;
+        }
+        if (index == LogicConfig::MAX_EXPRESSIONS)
+        {
+            LOG.warningf("ConfigManager", "More than %d logic expressions, ignoring the rest", LogicConfig::MAX_EXPRESSIONS);
+            break;
+        }
+
+        if (index == config.logic.numExpressions)
+        {
+            config.logic.numExpressions++;
+        }
+
+        LogicExpressionConfig &logicConfig = config.logic.expressions[index];
+        logicConfig.channel = channel;
+        strcpy(logicConfig.source, source);
+    }
+
+    // Every received frame opens one slot for all telemetry, so rates beyond 50Hz would only starve the others
+    JsonObject telemetry = doc["telemetry"];
+    config.telemetry.ratesHz[CrsfTelemetryFrame_BATTERY] = constrain(telemetry["batteryRate"] | CRSF_TELEMETRY_BATTERY_RATE_HZ, 0, 50);
+    config.telemetry.ratesHz[CrsfTelemetryFrame_FLIGHT_MODE] = constrain(telemetry["flightModeRate"] | CRSF_TELEMETRY_FLIGHT_MODE_RATE_HZ, 0, 50);
+    config.telemetry.ratesHz[CrsfTelemetryFrame_STATUS] = constrain(telemetry["statusRate"] | CRSF_TELEMETRY_STATUS_RATE_HZ, 0, 50);
+    config.telemetry.batteryChannel = constrain(telemetry["batteryChannel"] | 0, 0, CHANNEL_COUNT);
+    config.telemetry.batteryRatio = constrain(lroundf((telemetry["batteryRatio"] | 1.0f) * 100), 1, UINT16_MAX);
+
+    // Analog sensors, their pins are checked when the config is applied
+    for (JsonObject sensor : doc["sensors"].as<JsonArray>())
+    {
+        int channel = sensor["channel"] | 0;
+        if (channel < FIRST_SENSOR_CHANNEL || channel > CHANNEL_COUNT)
+        {
+            LOG.warningf("ConfigManager", "Ignoring sensor on channel %d", channel);
+            continue;
+        }
+
+        SensorConfig &sensorConfig = config.sensors[channel - FIRST_SENSOR_CHANNEL];
+        strncpy(sensorConfig.pin, sensor["pin"] | "", sizeof(sensorConfig.pin) - 1);
+        sensorConfig.minMv = constrain(sensor["min"] | 0, 0, 3300);
+        sensorConfig.maxMv = constrain(sensor["max"] | 2500, 0, 3300);
+        sensorConfig.filterMs = constrain(sensor["filter"] | 200, 0, 10000);
+    }
 }
@@ -3,34 +3,57 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <vector>
+#include <memory>
 #include "bordcomputer.hpp"
 #include "channel-handlers/pwmChannelHandler.hpp"
 #include "channel-handlers/onOffChannelHandler.hpp"
 #include "channel-handlers/blinkChannelHandler.hpp"
+#include "channel-handlers/sequenceChannelHandler.hpp"
+#include "channel-handlers/hbridgeChannelHandler.hpp"
+#include "channel-handlers/lightBarChannelHandler.hpp"
 #include "pin_map.hpp"
 #include "eeprom_manager.hpp"
 #include "config_versions.hpp"
 
+// Room for a full handler list, mixer, patterns and sensors when converting the config from and to JSON
+#define CONFIG_JSON_CAPACITY 28672
+
 class ConfigManager
 {
 public:
     ConfigManager(BoardComputer *computer, EEPROMManager *eeprom);
     bool load(const Config &config);
     bool loadFromJson(const char *jsonConfig);
-    Config getConfig();
+    const Config &getConfig() const;
+    bool keepWebServerRunning() const { return config.keepWebServerRunning; }
     String getConfigAsJson();
     bool loadFromEEPROM();
     bool begin();
+    bool configure(const Config &config); // Apply without persisting to EEPROM
 
 private:
     BoardComputer *computer;
     EEPROMManager *eeprom;
     Config config;
     bool eepromInitialized;
-    bool configure(const Config &config);
-    void configurePWMHandler(const HandlerConfig &config);
-    void configureOnOffHandler(const HandlerConfig &config);
-    void configureBlinkHandler(const HandlerConfig &config);
-    std::function<bool(uint16_t)> createThresholdFunction(const HandlerConfig &config);
-    Config parseJson(const char *jsonConfig);
+    IChannelHandler *liveHandlers[Config::MAX_HANDLERS]; // Running handler for each entry of config.handlers
+    CurvePool curvePool;
+    PatternPool patternPool;
+    IChannelHandler *findLiveHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[], bool claimed[]);
+    IChannelHandler *createHandler(const HandlerConfig &handlerConfig, const PatternConfig patterns[]);
+    IChannelHandler *configurePWMHandler(const HandlerConfig &config);
+    IChannelHandler *configureOnOffHandler(const HandlerConfig &config);
+    IChannelHandler *configureBlinkHandler(const HandlerConfig &config);
+    IChannelHandler *configureSequenceHandler(const HandlerConfig &config, const PatternConfig patterns[]);
+    IChannelHandler *configureHBridgeHandler(const HandlerConfig &config);
+    IChannelHandler *configureLightBarHandler(const HandlerConfig &config, const PatternConfig patterns[]);
+    bool acquirePatternPrograms(const HandlerConfig &config, const PatternConfig patterns[], PatternProgram *programs[]);
+    void releasePatternPrograms(PatternProgram *programs[]);
+    bool createSensorInputs(const Config &config, SensorInput inputs[]);
+    FailsafeProfile createFailsafeProfile(const HandlerConfig &config);
+    CurveParams createCurveParams(const HandlerConfig &config);
+    ConditioningProfile createConditioningProfile(const HandlerConfig &config);
+    ThresholdPredicate createThresholdPredicate(const HandlerConfig &config);
+    std::unique_ptr<Config> allocateConfig();
+    void parseJson(const char *jsonConfig, Config &config); // Fills a default constructed config
 };
\ No newline at end of file
@@ -2,6 +2,13 @@
 
 #include <Arduino.h>
 #include <type_traits>
+#include "const.hpp"
+#include "channels.hpp"
+#include "logic_engine.hpp"
+#include "channel-handlers/responseCurve.hpp"
+#include "channel-handlers/patternProgram.hpp"
+#include "crsf/crsf_telemetry.hpp"
+#include "inputs/input_decoder.hpp"
 
 struct HandlerConfig
 {
@@ -17,6 +24,37 @@ struct HandlerConfig
     int32_t offTime;   // Make explicit size
     bool inverted;
     uint8_t padding[3]; // Add explicit padding to align structure
+    int32_t failsafeHoldMs;   // Keep the last value this long after signal loss
+    int32_t failsafeRampRate; // µs per second towards the failsafe value, 0 to jump
+    int32_t hysteresis;       // µs the value has to pass the threshold by before the output switches
+    int32_t expo;             // PWM response curve, see CurveParams
+    int32_t endpointLow;
+    int32_t endpointHigh;
+    int32_t subtrim;
+    uint8_t numCurvePoints;
+    int8_t curvePoints[CURVE_MAX_POINTS];
+    uint8_t curvePadding[2];
+    int32_t slewRate;         // Output conditioning, see ConditioningProfile
+    int32_t filterMs;
+    bool interpolate;
+    uint8_t phaseGroup; // Blink and sequence outputs in the same group share their timebase, 0 for none
+    uint8_t conditioningPadding[2];
+    uint8_t numPatterns;             // Sequence: one pattern per band of the channel range, lowest first
+    uint8_t patterns[PATTERN_SLOTS]; // Pattern numbers 1..PATTERN_COUNT, 0 for off
+    uint8_t patternPadding;
+    uint16_t phaseOffsetMs;          // Sequence: runs this far ahead of its phase group
+    uint16_t frequency;              // PWM: output frequency in Hz
+    uint8_t resolution;              // PWM: duty resolution in bits
+    uint8_t unit;                    // PWM: PWMUnit of min and max
+    char pin2[16];                   // H-bridge: pin driven for reverse, pin drives forward
+    uint16_t deadband;               // H-bridge: µs around the center that count as stop
+    uint16_t deadTimeMs;             // H-bridge: both sides off this long on reversal
+    uint16_t rampMs;                 // H-bridge: stop to full speed, 0 for no ramp
+    uint8_t failsafeMode;            // H-bridge: HBridgeStopMode
+    uint8_t hbridgePadding;
+    uint16_t numPixels;              // Light bar: WS2812 pixels on the pin
+    uint8_t color[3];                // Light bar: red, green, blue at full level
+    uint8_t lightBarPadding;
 
     // Initialize all fields in constructor
     HandlerConfig()
@@ -33,6 +71,37 @@ struct HandlerConfig
         offTime = 400;
         inverted = false;
         memset(padding, 0, sizeof(padding));
+        failsafeHoldMs = 0;
+        failsafeRampRate = 0;
+        hysteresis = 0;
+        expo = 0;
+        endpointLow = 100;
+        endpointHigh = 100;
+        subtrim = 0;
+        numCurvePoints = 0;
+        memset(curvePoints, 0, sizeof(curvePoints));
+        memset(curvePadding, 0, sizeof(curvePadding));
+        slewRate = 0;
+        filterMs = 0;
+        interpolate = false;
+        phaseGroup = 0;
+        memset(conditioningPadding, 0, sizeof(conditioningPadding));
+        numPatterns = 0;
+        memset(patterns, 0, sizeof(patterns));
+        patternPadding = 0;
+        phaseOffsetMs = 0;
+        frequency = 50;
+        resolution = 14;
+        unit = 0;
+        memset(pin2, 0, sizeof(pin2));
+        deadband = 20;
+        deadTimeMs = 50;
+        rampMs = 500;
+        failsafeMode = 0;
+        hbridgePadding = 0;
+        numPixels = 0;
+        memset(color, 255, sizeof(color));
+        lightBarPadding = 0;
     }
 
     // Helper function to safely set strings
@@ -46,26 +115,198 @@ struct HandlerConfig
         strncpy(pin, p, sizeof(pin) - 1);
         pin[sizeof(pin) - 1] = '\0';
     }
+    void setPin2(const char *p)
+    {
+        strncpy(pin2, p, sizeof(pin2) - 1);
+        pin2[sizeof(pin2) - 1] = '\0';
+    }
     void setOp(const char *o)
     {
         strncpy(op, o, sizeof(op) - 1);
         op[sizeof(op) - 1] = '\0';
     }
+
+    // Field-wise comparison, padding bytes are not guaranteed to match
+    bool sameAs(const HandlerConfig &other) const
+    {
+        return strcmp(type, other.type) == 0 &&
+               strcmp(pin, other.pin) == 0 &&
+               strcmp(op, other.op) == 0 &&
+               channel == other.channel &&
+               failsafe == other.failsafe &&
+               threshold == other.threshold &&
+               min == other.min &&
+               max == other.max &&
+               onTime == other.onTime &&
+               offTime == other.offTime &&
+               inverted == other.inverted &&
+               failsafeHoldMs == other.failsafeHoldMs &&
+               failsafeRampRate == other.failsafeRampRate &&
+               hysteresis == other.hysteresis &&
+               expo == other.expo &&
+               endpointLow == other.endpointLow &&
+               endpointHigh == other.endpointHigh &&
+               subtrim == other.subtrim &&
+               numCurvePoints == other.numCurvePoints &&
+               memcmp(curvePoints, other.curvePoints, numCurvePoints) == 0 &&
+               slewRate == other.slewRate &&
+               filterMs == other.filterMs &&
+               interpolate == other.interpolate &&
+               phaseGroup == other.phaseGroup &&
+               numPatterns == other.numPatterns &&
+               memcmp(patterns, other.patterns, numPatterns) == 0 &&
+               phaseOffsetMs == other.phaseOffsetMs &&
+               frequency == other.frequency &&
+               resolution == other.resolution &&
+               unit == other.unit &&
+               strcmp(pin2, other.pin2) == 0 &&
+               deadband == other.deadband &&
+               deadTimeMs == other.deadTimeMs &&
+               rampMs == other.rampMs &&
+               failsafeMode == other.failsafeMode &&
+               numPixels == other.numPixels &&
+               memcmp(color, other.color, sizeof(color)) == 0;
+    }
+};
+
+struct MixerTermConfig
+{
+    uint8_t input;  // 1-based RC channel
+    uint8_t output; // 1-based mixer channel
+    int16_t weight; // Percent of the input's deflection from center
+};
+
+struct MixerConfig
+{
+    // Stored terms are kept well below MIXER_MAX_TERMS so the config stays small enough for EEPROM and task stacks
+    static constexpr size_t MAX_TERMS = 64;
+    uint32_t outputs;                     // Bit n set if mixer channel FIRST_MIXER_CHANNEL + n is defined
+    uint32_t numTerms;
+    int16_t offsets[MIXER_CHANNEL_COUNT]; // µs added to each output's center
+    MixerTermConfig terms[MAX_TERMS];
+
+    MixerConfig()
+    {
+        outputs = 0;
+        numTerms = 0;
+        memset(offsets, 0, sizeof(offsets));
+        memset(terms, 0, sizeof(terms));
+    }
+};
+
+struct LogicExpressionConfig
+{
+    uint8_t channel;                   // FIRST_LOGIC_CHANNEL..LAST_LOGIC_CHANNEL
+    char source[LOGIC_MAX_EXPRESSION]; // Compiled when the config is applied
+};
+
+struct LogicConfig
+{
+    // Only expressions in use are stored, room for every logic channel would take up most of the config
+    static constexpr size_t MAX_EXPRESSIONS = 8;
+    uint32_t numExpressions;
+    LogicExpressionConfig expressions[MAX_EXPRESSIONS];
+
+    LogicConfig()
+    {
+        numExpressions = 0;
+        memset(expressions, 0, sizeof(expressions));
+    }
+};
+
+struct SensorConfig
+{
+    char pin[16];      // Empty if the sensor channel is unused
+    uint16_t minMv;    // Pin voltage published as CHANNEL_MIN
+    uint16_t maxMv;    // Pin voltage published as CHANNEL_MAX
+    uint16_t filterMs; // Time constant of the low pass, 0 for none
+    uint16_t padding;
+
+    SensorConfig()
+    {
+        memset(pin, 0, sizeof(pin));
+        minMv = 0;
+        maxMv = 2500;
+        filterMs = 200;
+        padding = 0;
+    }
+
+    bool operator==(const SensorConfig &other) const
+    {
+        return strcmp(pin, other.pin) == 0 && minMv == other.minMv && maxMv == other.maxMv && filterMs == other.filterMs;
+    }
+    bool operator!=(const SensorConfig &other) const { return !(*this == other); }
+};
+
+struct TelemetryConfig
+{
+    uint8_t ratesHz[CrsfTelemetryFrame_COUNT]; // Frames per second per CrsfTelemetryFrame, 0 for off
+    uint8_t batteryChannel;                    // Sensor channel measuring the battery, 0 for none
+    uint16_t batteryRatio;                     // Battery voltage per pin voltage, in 1/100
+    uint16_t padding;
+
+    TelemetryConfig()
+    {
+        ratesHz[CrsfTelemetryFrame_BATTERY] = CRSF_TELEMETRY_BATTERY_RATE_HZ;
+        ratesHz[CrsfTelemetryFrame_FLIGHT_MODE] = CRSF_TELEMETRY_FLIGHT_MODE_RATE_HZ;
+        ratesHz[CrsfTelemetryFrame_STATUS] = CRSF_TELEMETRY_STATUS_RATE_HZ;
+        batteryChannel = 0;
+        batteryRatio = 100;
+        padding = 0;
+    }
 };
 
 namespace ConfigVersions
 {
 
+    // Layouts of earlier versions are frozen, they are only read to migrate a stored config
+
+    struct HandlerConfigV1
+    {
+        char type[16];
+        char pin[16];
+        char op[16];
+        uint8_t channel;
+        int32_t failsafe;
+        int32_t threshold;
+        int32_t min;
+        int32_t max;
+        int32_t onTime;
+        int32_t offTime;
+        bool inverted;
+        uint8_t padding[3];
+    };
+
     struct ConfigV1
     {
         static constexpr size_t MAX_HANDLERS = 20;
         uint32_t numHandlers;
+        HandlerConfigV1 handlers[MAX_HANDLERS];
+        char apSsid[32];
+        char apPassword[32];
+        bool keepWebServerRunning;
+    };
+
+    // Current layout. Changing it needs a ConfigV3, a migrate() from this one and a new CURRENT_VERSION
+    struct ConfigV2
+    {
+        static constexpr size_t MAX_HANDLERS = MAX_CHANNEL_HANDLERS;
+        uint32_t numHandlers;
         HandlerConfig handlers[MAX_HANDLERS];
         char apSsid[32];
         char apPassword[32];
         bool keepWebServerRunning;
+        uint8_t failsafeMinLinkQuality; // Uplink LQ (%) below which failsafe starts, 0 to disable
+        uint16_t failsafeFrameGapMs;    // Time without RC frames before failsafe starts
+        MixerConfig mixer;
+        LogicConfig logic;                                     // Expressions of the logic channels in use
+        PatternConfig patterns[PATTERN_COUNT];                 // Light patterns referenced by sequence handlers
+        bool alignOutputCommits;                               // Commit PWM duties just before their period starts
+        SensorConfig sensors[SENSOR_CHANNEL_COUNT];            // Analog input per sensor channel
+        TelemetryConfig telemetry;                             // Frames sent back to the radio
+        uint8_t inputProtocol;                                 // InputProtocol the receiver speaks
 
-        ConfigV1()
+        ConfigV2()
         {
             numHandlers = 0;
             strncpy(apSsid, "Bordcomputer", sizeof(apSsid) - 1);
@@ -73,11 +314,44 @@ namespace ConfigVersions
             apSsid[sizeof(apSsid) - 1] = '\0';
             apPassword[sizeof(apPassword) - 1] = '\0';
             keepWebServerRunning = false;
+            failsafeMinLinkQuality = 0;
+            failsafeFrameGapMs = FAILSAFE_FRAME_GAP_MS;
+            alignOutputCommits = false;
+            inputProtocol = InputProtocol_CRSF;
         }
     };
 
+    /**
+     * @brief Carry a version 1 config over, everything added since keeps the defaults of `to`
+     */
+    inline void migrate(const ConfigV1 &from, ConfigV2 &to)
+    {
+        to.numHandlers = min(from.numHandlers, (uint32_t)ConfigV2::MAX_HANDLERS);
+        for (size_t i = 0; i < to.numHandlers; i++)
+        {
+            const HandlerConfigV1 &stored = from.handlers[i];
+            HandlerConfig &handler = to.handlers[i];
+            memcpy(handler.type, stored.type, sizeof(handler.type));
+            memcpy(handler.pin, stored.pin, sizeof(handler.pin));
+            memcpy(handler.op, stored.op, sizeof(handler.op));
+            handler.channel = stored.channel;
+            handler.failsafe = stored.failsafe;
+            handler.threshold = stored.threshold;
+            handler.min = stored.min;
+            handler.max = stored.max;
+            handler.onTime = stored.onTime;
+            handler.offTime = stored.offTime;
+            handler.inverted = stored.inverted;
+        }
+
+        memcpy(to.apSsid, from.apSsid, sizeof(to.apSsid));
+        memcpy(to.apPassword, from.apPassword, sizeof(to.apPassword));
+        to.keepWebServerRunning = from.keepWebServerRunning;
+    }
+
 }
 
-using Config = ConfigVersions::ConfigV1;
+using Config = ConfigVersions::ConfigV2;
 
-static_assert(std::is_standard_layout<Config>::value, "Config must be standard layout for EEPROM storage");
\ No newline at end of file
+static_assert(std::is_standard_layout<Config>::value, "Config must be standard layout for EEPROM storage");
+static_assert(sizeof(ConfigVersions::ConfigV1) == 1672, "Stored version 1 configs have this size, ConfigV1 must not change");
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "crsf_baud_negotiator.hpp"
+#include "const.hpp"
+#include "logger.hpp"
+#include <driver/uart.h>
+
+CrsfBaudNegotiator::CrsfBaudNegotiator(HardwareSerial *serial, CrsfDecoder *decoder)
+    : serial(serial), decoder(decoder), state(State_DEFAULT_RATE), baudRate(CRSF_BAUDRATE),
+      stateSince(0), linkUpSince(0), lastFrameTime(0), retryAfter(0), lastFrameCount(0), framesAtSwitch(0)
+{
+}
+
+void CrsfBaudNegotiator::reset()
+{
+    state = State_DEFAULT_RATE;
+    baudRate = CRSF_BAUDRATE;
+    stateSince = 0;
+    linkUpSince = 0;
+    lastFrameTime = 0;
+    retryAfter = 0;
+    lastFrameCount = 0;
+    framesAtSwitch = 0;
+}
+
+void CrsfBaudNegotiator::update(unsigned long currentTime)
+{
+    if (CRSF_MAX_BAUDRATE <= CRSF_BAUDRATE)
+    {
+        return; // Negotiation disabled
+    }
+
+    uint32_t frameCount = decoder->getStats().framesDecoded;
+    if (frameCount != lastFrameCount)
+    {
+        lastFrameCount = frameCount;
+        lastFrameTime = currentTime;
+    }
+    bool linkUp = decoder->isLinkUp();
+
+    switch (state)
+    {
+    case State_DEFAULT_RATE:
+        if (!linkUp)
+        {
+            linkUpSince = 0;
+            // Nothing decodes at the default rate, the receiver may still be on the fast one
+            if (currentTime - lastFrameTime >= CRSF_BAUD_SCAN_MS &&
+                currentTime - stateSince >= CRSF_BAUD_SCAN_MS)
+            {
+                switchBaudRate(baudRate == CRSF_BAUDRATE ? CRSF_MAX_BAUDRATE : CRSF_BAUDRATE);
+                stateSince = currentTime;
+            }
+            break;
+        }
+
+        if (baudRate != CRSF_BAUDRATE)
+        {
+            LOG.infof("CrsfBaudNegotiator", "Receiver found at %lu baud", baudRate);
+            setState(State_NEGOTIATED, currentTime);
+            break;
+        }
+
+        if (linkUpSince == 0)
+        {
+            linkUpSince = currentTime;
+        }
+
+        if (currentTime - linkUpSince >= CRSF_BAUD_SETTLE_MS && (long)(currentTime - retryAfter) >= 0)
+        {
+            decoder->takeSpeedResponse(); // Drop any stale answer
+            sendProposal(CRSF_MAX_BAUDRATE);
+            setState(State_PROPOSED, currentTime);
+        }
+        break;
+
+    case State_PROPOSED:
+        switch (decoder->takeSpeedResponse())
+        {
+        case CrsfSpeedResponse_ACCEPTED:
+            LOG.infof("CrsfBaudNegotiator", "Receiver accepted %d baud", CRSF_MAX_BAUDRATE);
+            switchBaudRate(CRSF_MAX_BAUDRATE);
+            framesAtSwitch = frameCount;
+            setState(State_CONFIRMING, currentTime);
+            break;
+
+        case CrsfSpeedResponse_REJECTED:
+            LOG.infof("CrsfBaudNegotiator", "Receiver rejected %d baud, staying at %d", CRSF_MAX_BAUDRATE, CRSF_BAUDRATE);
+            retryAfter = currentTime + CRSF_BAUD_RETRY_MS;
+            setState(State_DEFAULT_RATE, currentTime);
+            break;
+
+        default:
+            if (currentTime - stateSince >= CRSF_BAUD_RESPONSE_TIMEOUT_MS)
+            {
+                LOG.warning("CrsfBaudNegotiator", "No answer to baud rate proposal");
+                retryAfter = currentTime + CRSF_BAUD_RETRY_MS;
+                setState(State_DEFAULT_RATE, currentTime);
+            }
+            break;
+        }
+        break;
+
+    case State_CONFIRMING:
+        if (frameCount - framesAtSwitch >= CRSF_BAUD_CONFIRM_FRAMES)
+        {
+            LOG.infof("CrsfBaudNegotiator", "Link running at %lu baud", baudRate);
+            setState(State_NEGOTIATED, currentTime);
+        }
+        else if (currentTime - stateSince >= CRSF_BAUD_CONFIRM_MS)
+        {
+            LOG.warningf("CrsfBaudNegotiator", "No frames at %lu baud, falling back to %d", baudRate, CRSF_BAUDRATE);
+            switchBaudRate(CRSF_BAUDRATE);
+            retryAfter = currentTime + CRSF_BAUD_RETRY_MS;
+            setState(State_DEFAULT_RATE, currentTime);
+        }
+        break;
+
+    case State_NEGOTIATED:
+        if (currentTime - lastFrameTime >= CRSF_BAUD_SCAN_MS)
+        {
+            LOG.warningf("CrsfBaudNegotiator", "Link silent at %lu baud, falling back to %d", baudRate, CRSF_BAUDRATE);
+            switchBaudRate(CRSF_BAUDRATE);
+            setState(State_DEFAULT_RATE, currentTime);
+        }
+        break;
+    }
+}
+
+void CrsfBaudNegotiator::setState(State newState, unsigned long currentTime)
+{
+    state = newState;
+    stateSince = currentTime;
+}
+
+void CrsfBaudNegotiator::switchBaudRate(uint32_t newBaudRate)
+{
+    // Let a pending proposal leave at the old rate. flush() would also wait for queued
+    // telemetry, which the receiver drops anyway once the rates differ.
+    uart_wait_tx_done(CRSF_UART_NUM, pdMS_TO_TICKS(CRSF_BAUD_TX_WAIT_MS));
+    serial->updateBaudRate(newBaudRate);
+    baudRate = newBaudRate;
+}
+
+void CrsfBaudNegotiator::sendProposal(uint32_t proposedBaudRate)
+{
+    uint8_t frame[14];
+    frame[0] = CRSF_SYNC_BYTE;
+    frame[1] = sizeof(frame) - 2;
+    frame[2] = CRSF_FRAMETYPE_COMMAND;
+    frame[3] = CRSF_ADDRESS_RECEIVER;
+    frame[4] = CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[5] = CRSF_COMMAND_GENERAL;
+    frame[6] = CRSF_COMMAND_GENERAL_SPEED_PROPOSAL;
+    frame[7] = 0; // Port id
+    frame[8] = proposedBaudRate >> 24;
+    frame[9] = proposedBaudRate >> 16;
+    frame[10] = proposedBaudRate >> 8;
+    frame[11] = proposedBaudRate;
+    frame[12] = crsfCommandCrc8(frame + 2, 10);
+    frame[13] = crsfCrc8(frame + 2, 11);
+
+    LOG.debugf("CrsfBaudNegotiator", "Proposing %lu baud", proposedBaudRate);
+    serial->write(frame, sizeof(frame));
+}
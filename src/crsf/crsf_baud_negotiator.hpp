@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Arduino.h>
+#include "crsf_decoder.hpp"
+
+#define CRSF_BAUD_SETTLE_MS 1000           // Link must be stable this long before proposing
+#define CRSF_BAUD_RESPONSE_TIMEOUT_MS 250  // Time the receiver gets to answer a proposal
+#define CRSF_BAUD_CONFIRM_MS 500           // Frames must decode at the new rate within this time
+#define CRSF_BAUD_SCAN_MS 100              // Silence after which the other rate is tried, a few frames at the slowest packet rate
+#define CRSF_BAUD_RETRY_MS 30000           // Back-off after a failed negotiation
+#define CRSF_BAUD_CONFIRM_FRAMES 10
+#define CRSF_BAUD_TX_WAIT_MS 1             // Longest wait for the proposal to leave before switching the UART
+
+/**
+ * @brief Moves the CRSF link above CRSF_BAUDRATE using the speed proposal command
+ *
+ * Proposes CRSF_MAX_BAUDRATE once the link is stable, switches the UART when the
+ * receiver accepts and falls back to CRSF_BAUDRATE if frames stop decoding.
+ * When the link is lost the default rate is tried first, then it alternates
+ * between both rates every CRSF_BAUD_SCAN_MS, so a receiver that kept the
+ * negotiated rate across a board reset or a TX-off failsafe is found again.
+ */
+class CrsfBaudNegotiator
+{
+public:
+    CrsfBaudNegotiator(HardwareSerial *serial, CrsfDecoder *decoder);
+
+    /**
+     * @brief Advance the negotiation, called once per control tick
+     */
+    void update(unsigned long currentTime);
+
+    /**
+     * @brief Start over at CRSF_BAUDRATE, called when the UART was set up again
+     */
+    void reset();
+
+    uint32_t getBaudRate() const { return baudRate; }
+
+private:
+    enum State
+    {
+        State_DEFAULT_RATE,
+        State_PROPOSED,
+        State_CONFIRMING,
+        State_NEGOTIATED
+    };
+
+    HardwareSerial *serial;
+    CrsfDecoder *decoder;
+    State state;
+    uint32_t baudRate;
+    unsigned long stateSince;
+    unsigned long linkUpSince;
+    unsigned long lastFrameTime;
+    unsigned long retryAfter;
+    uint32_t lastFrameCount;
+    uint32_t framesAtSwitch;
+
+    void setState(State newState, unsigned long currentTime);
+    void switchBaudRate(uint32_t newBaudRate);
+    void sendProposal(uint32_t proposedBaudRate);
+};
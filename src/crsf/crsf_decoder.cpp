@@ -0,0 +1,178 @@
+#include "crsf_decoder.hpp"
+#include "bordcomputer.hpp"
+
+// Frame length byte covers type + payload + crc
+static const uint8_t RC_CHANNELS_FRAME_LENGTH = 1 + 22 + 1;
+// type + destination + origin + command + subcommand + port + status + command crc + crc
+static const uint8_t SPEED_RESPONSE_FRAME_LENGTH = 9;
+static const uint8_t LINK_STATISTICS_FRAME_LENGTH = 1 + sizeof(CrsfLinkStatistics) + 1;
+static_assert(sizeof(CrsfLinkStatistics) == 10, "CrsfLinkStatistics must match the LINK_STATISTICS payload");
+
+static inline bool isSyncByte(uint8_t value)
+{
+    // Flight controller address, plus the addresses some receivers use instead
+    return value == CRSF_SYNC_BYTE || value == 0xEE || value == 0xEA || value == 0xEC;
+}
+
+CrsfDecoder::CrsfDecoder()
+    : port(nullptr), rxLength(0), lastLinkStatisticsTime(0), speedResponse(CrsfSpeedResponse_NONE)
+{
+    memset(&linkStatistics, 0, sizeof(linkStatistics));
+}
+
+void CrsfDecoder::begin(Stream &port, uint16_t *channelValues)
+{
+    reset(channelValues);
+    this->port = &port;
+    this->rxLength = 0;
+    this->lastLinkStatisticsTime = 0;
+    this->speedResponse = CrsfSpeedResponse_NONE;
+}
+
+void CrsfDecoder::update()
+{
+    if (!port)
+    {
+        return;
+    }
+
+    uint32_t startCycles = ESP.getCycleCount();
+
+    int available;
+    while ((available = port->available()) > 0)
+    {
+        size_t space = sizeof(rxBuffer) - rxLength;
+        size_t count = min((size_t)available, space);
+        rxLength += port->readBytes(rxBuffer + rxLength, count);
+
+        // The buffer is larger than any frame, so parse() always makes progress when it is full
+        size_t consumed = parse();
+        if (consumed > 0 && consumed < rxLength)
+        {
+            // Keep the partial frame at the start of the buffer (at most one frame worth of bytes)
+            memmove(rxBuffer, rxBuffer + consumed, rxLength - consumed);
+        }
+        rxLength -= consumed;
+    }
+
+    stats.lastUpdateCycles = ESP.getCycleCount() - startCycles;
+}
+
+size_t CrsfDecoder::parse()
+{
+    size_t position = 0;
+
+    while (rxLength - position >= 2)
+    {
+        const uint8_t *frame = rxBuffer + position;
+        uint8_t frameLength = frame[1];
+
+        if (!isSyncByte(frame[0]) || frameLength < 2 || frameLength > CRSF_MAX_FRAME_SIZE - 2)
+        {
+            // Not the start of a frame, resynchronise on the next byte
+            position++;
+            stats.bytesDiscarded++;
+            continue;
+        }
+
+        size_t totalLength = frameLength + 2;
+        if (rxLength - position < totalLength)
+        {
+            break; // Wait for the rest of the frame
+        }
+
+        if (crsfCrc8(frame + 2, frameLength - 1) != frame[totalLength - 1])
+        {
+            position++;
+            stats.crcErrors++;
+            stats.bytesDiscarded++;
+            continue;
+        }
+
+        handleFrame(frame);
+        stats.framesDecoded++;
+        position += totalLength;
+    }
+
+    return position;
+}
+
+void CrsfDecoder::handleFrame(const uint8_t *frame)
+{
+    uint8_t frameLength = frame[1];
+    uint8_t type = frame[2];
+    const uint8_t *payload = frame + 3;
+
+    switch (type)
+    {
+    case CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
+        if (frameLength == RC_CHANNELS_FRAME_LENGTH)
+        {
+            // Reading one past the payload for the last channel hits the CRC byte
+            unpackChannels11(payload);
+            channelsReceived();
+        }
+        break;
+
+    case CRSF_FRAMETYPE_LINK_STATISTICS:
+        if (frameLength == LINK_STATISTICS_FRAME_LENGTH)
+        {
+            // Payload is the packed struct, all single bytes
+            memcpy(&linkStatistics, payload, sizeof(linkStatistics));
+            lastLinkStatisticsTime = millis();
+        }
+        break;
+
+    case CRSF_FRAMETYPE_COMMAND:
+        handleCommand(frame);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void CrsfDecoder::handleCommand(const uint8_t *frame)
+{
+    uint8_t frameLength = frame[1];
+    if (frameLength != SPEED_RESPONSE_FRAME_LENGTH || frame[3] != CRSF_ADDRESS_FLIGHT_CONTROLLER)
+    {
+        return;
+    }
+
+    // The command CRC covers everything from the type up to the command payload
+    uint8_t commandCrc = frame[frameLength];
+    if (crsfCommandCrc8(frame + 2, frameLength - 2) != commandCrc)
+    {
+        stats.crcErrors++;
+        return;
+    }
+
+    if (frame[5] == CRSF_COMMAND_GENERAL && frame[6] == CRSF_COMMAND_GENERAL_SPEED_RESPONSE)
+    {
+        speedResponse = frame[8] ? CrsfSpeedResponse_ACCEPTED : CrsfSpeedResponse_REJECTED;
+    }
+}
+
+bool CrsfDecoder::getLinkStatistics(CrsfLinkStatistics &linkStatistics) const
+{
+    if (lastLinkStatisticsTime == 0 || millis() - lastLinkStatisticsTime >= CRSF_LINK_STATISTICS_TIMEOUT_MS)
+    {
+        return false;
+    }
+
+    linkStatistics = this->linkStatistics;
+    return true;
+}
+
+CrsfSpeedResponse CrsfDecoder::takeSpeedResponse()
+{
+    CrsfSpeedResponse response = speedResponse;
+    speedResponse = CrsfSpeedResponse_NONE;
+    return response;
+}
+
+bool CrsfDecoder::isLinkUp() const
+{
+    return lastChannelsTime != 0 && (millis() - lastChannelsTime) < CRSF_LINK_TIMEOUT_MS;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include "crsf_protocol.hpp"
+#include "inputs/input_decoder.hpp"
+
+#define CRSF_RX_BUFFER_SIZE 256
+#define CRSF_LINK_TIMEOUT_MS 300
+#define CRSF_LINK_STATISTICS_TIMEOUT_MS 1000
+
+enum CrsfSpeedResponse
+{
+    CrsfSpeedResponse_NONE,
+    CrsfSpeedResponse_ACCEPTED,
+    CrsfSpeedResponse_REJECTED
+};
+
+struct CrsfLinkStatistics
+{
+    uint8_t uplinkRssi1; // dBm * -1
+    uint8_t uplinkRssi2; // dBm * -1
+    uint8_t uplinkLinkQuality;
+    int8_t uplinkSnr;
+    uint8_t activeAntenna;
+    uint8_t rfMode;
+    uint8_t uplinkTxPower;
+    uint8_t downlinkRssi; // dBm * -1
+    uint8_t downlinkLinkQuality;
+    int8_t downlinkSnr;
+};
+
+/**
+ * @brief Parses CRSF frames in place from the receive buffer
+ *
+ * Bytes are pulled from the UART in one bulk read per update() and frames are
+ * validated and decoded where they sit, without copying them into a packet buffer.
+ * RC channels are unpacked straight into the channel array given to begin().
+ */
+class CrsfDecoder : public InputDecoder
+{
+public:
+    CrsfDecoder();
+
+    /**
+     * @brief Attach the decoder to the receiver's serial port
+     * @param port Stream the CRSF receiver is connected to
+     * @param channelValues Array of CRSF_RC_CHANNEL_COUNT values (in µs) that RC frames are unpacked into
+     */
+    void begin(Stream &port, uint16_t *channelValues);
+
+    /**
+     * @brief Read everything available from the port and decode all complete frames
+     */
+    void update() override;
+
+    /**
+     * @brief Check if RC channel frames arrived within CRSF_LINK_TIMEOUT_MS
+     */
+    bool isLinkUp() const;
+
+    /**
+     * @brief Get the last LINK_STATISTICS frame
+     * @return false if none arrived within CRSF_LINK_STATISTICS_TIMEOUT_MS
+     */
+    bool getLinkStatistics(CrsfLinkStatistics &linkStatistics) const override;
+
+    /**
+     * @brief Get and reset the receiver's answer to the last baud rate proposal
+     */
+    CrsfSpeedResponse takeSpeedResponse();
+
+private:
+    Stream *port;
+    uint8_t rxBuffer[CRSF_RX_BUFFER_SIZE];
+    size_t rxLength;
+    CrsfLinkStatistics linkStatistics;
+    unsigned long lastLinkStatisticsTime;
+    CrsfSpeedResponse speedResponse;
+
+    size_t parse();
+    void handleFrame(const uint8_t *frame);
+    void handleCommand(const uint8_t *frame);
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define CRSF_SYNC_BYTE 0xC8
+#define CRSF_MAX_FRAME_SIZE 64 // sync + length + type + payload + crc
+#define CRSF_RC_CHANNEL_COUNT 16
+
+// Device addresses
+#define CRSF_ADDRESS_FLIGHT_CONTROLLER 0xC8
+#define CRSF_ADDRESS_RADIO_TRANSMITTER 0xEA
+#define CRSF_ADDRESS_RECEIVER 0xEC
+#define CRSF_ADDRESS_TRANSMITTER_MODULE 0xEE
+
+// Frame types
+#define CRSF_FRAMETYPE_BATTERY_SENSOR 0x08
+#define CRSF_FRAMETYPE_LINK_STATISTICS 0x14
+#define CRSF_FRAMETYPE_RC_CHANNELS_PACKED 0x16
+#define CRSF_FRAMETYPE_FLIGHT_MODE 0x21
+#define CRSF_FRAMETYPE_COMMAND 0x32
+// Not part of CRSF, has the extended header so the link passes it to the radio untouched
+#define CRSF_FRAMETYPE_BOARD_STATUS 0x7F
+
+// Command frames (extended header: destination + origin follow the type)
+#define CRSF_COMMAND_GENERAL 0x0A
+#define CRSF_COMMAND_GENERAL_SPEED_PROPOSAL 0x70
+#define CRSF_COMMAND_GENERAL_SPEED_RESPONSE 0x71
+
+/**
+ * @brief CRC8 over type + payload, polynomial 0xD5
+ */
+uint8_t crsfCrc8(const uint8_t *data, uint8_t length);
+
+/**
+ * @brief Inner CRC8 of command frames, polynomial 0xBA
+ */
+uint8_t crsfCommandCrc8(const uint8_t *data, uint8_t length);
@@ -0,0 +1,129 @@
+#include "crsf_telemetry.hpp"
+#include "logger.hpp"
+
+static inline uint8_t *putUint16(uint8_t *position, uint16_t value)
+{
+    position[0] = value >> 8;
+    position[1] = value;
+    return position + 2;
+}
+
+CrsfTelemetry::CrsfTelemetry(HardwareSerial *serial, CrsfDecoder *decoder)
+    : serial(serial), decoder(decoder), lastFrameCount(0)
+{
+    memset(lastSent, 0, sizeof(lastSent));
+    memset(txBuffer, 0, sizeof(txBuffer));
+    memset(&stats, 0, sizeof(stats));
+
+    const uint8_t defaultRates[CrsfTelemetryFrame_COUNT] = {CRSF_TELEMETRY_BATTERY_RATE_HZ,
+                                                            CRSF_TELEMETRY_FLIGHT_MODE_RATE_HZ,
+                                                            CRSF_TELEMETRY_STATUS_RATE_HZ};
+    setRates(defaultRates);
+}
+
+void CrsfTelemetry::setRates(const uint8_t ratesHz[CrsfTelemetryFrame_COUNT])
+{
+    for (uint8_t i = 0; i < CrsfTelemetryFrame_COUNT; i++)
+    {
+        intervalsMs[i] = ratesHz[i] > 0 ? 1000 / ratesHz[i] : 0;
+    }
+}
+
+CrsfTelemetryFrame CrsfTelemetry::takeDueFrame(unsigned long currentTime)
+{
+    // Every frame from the receiver opens one slot, slots nobody used are not saved up
+    uint32_t frameCount = decoder->getStats().framesDecoded;
+    if (frameCount == lastFrameCount)
+    {
+        return CrsfTelemetryFrame_NONE;
+    }
+    lastFrameCount = frameCount;
+
+    CrsfTelemetryFrame due = CrsfTelemetryFrame_NONE;
+    unsigned long mostOverdue = 0;
+    for (uint8_t i = 0; i < CrsfTelemetryFrame_COUNT; i++)
+    {
+        unsigned long elapsed = currentTime - lastSent[i];
+        if (intervalsMs[i] == 0 || elapsed < intervalsMs[i])
+        {
+            continue;
+        }
+
+        unsigned long overdue = elapsed - intervalsMs[i];
+        if (due == CrsfTelemetryFrame_NONE || overdue > mostOverdue)
+        {
+            due = (CrsfTelemetryFrame)i;
+            mostOverdue = overdue;
+        }
+    }
+
+    if (due != CrsfTelemetryFrame_NONE)
+    {
+        lastSent[due] = currentTime;
+    }
+    return due;
+}
+
+uint8_t *CrsfTelemetry::beginFrame(uint8_t type)
+{
+    txBuffer[0] = CRSF_SYNC_BYTE;
+    txBuffer[2] = type;
+    return txBuffer + 3;
+}
+
+void CrsfTelemetry::endFrame(uint8_t *end)
+{
+    // Length covers type, payload and crc
+    uint8_t length = end - txBuffer - 1;
+    txBuffer[1] = length;
+    *end = crsfCrc8(txBuffer + 2, length - 1);
+
+    size_t totalLength = length + 2;
+    if (serial->availableForWrite() < (int)totalLength)
+    {
+        // The line is still busy with earlier frames, waiting would stall the control task
+        stats.framesDropped++;
+        return;
+    }
+
+    serial->write(txBuffer, totalLength);
+    stats.framesSent++;
+}
+
+void CrsfTelemetry::sendBattery(uint16_t decivolts)
+{
+    uint8_t *position = beginFrame(CRSF_FRAMETYPE_BATTERY_SENSOR);
+    position = putUint16(position, decivolts);
+    position = putUint16(position, 0); // Current, not measured
+    *position++ = 0;                   // Used capacity, 24 bits
+    *position++ = 0;
+    *position++ = 0;
+    *position++ = 0; // Remaining percent
+    endFrame(position);
+}
+
+void CrsfTelemetry::sendFlightMode(const char *mode)
+{
+    uint8_t *position = beginFrame(CRSF_FRAMETYPE_FLIGHT_MODE);
+    size_t length = strnlen(mode, CRSF_TELEMETRY_FLIGHT_MODE_LENGTH - 1);
+    memcpy(position, mode, length);
+    position += length;
+    *position++ = '\0';
+    endFrame(position);
+}
+
+void CrsfTelemetry::sendBoardStatus(const CrsfBoardStatus &boardStatus)
+{
+    uint8_t *position = beginFrame(CRSF_FRAMETYPE_BOARD_STATUS);
+    *position++ = CRSF_ADDRESS_RADIO_TRANSMITTER;
+    *position++ = CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    *position++ = boardStatus.status;
+    *position++ = boardStatus.failsafeStage;
+    position = putUint16(position, boardStatus.maxTickUs);
+    position = putUint16(position, boardStatus.tickOverruns);
+    for (uint8_t i = 0; i < CRSF_TELEMETRY_STATUS_SENSORS; i++)
+    {
+        position = putUint16(position, boardStatus.sensorMillivolts[i]);
+    }
+    endFrame(position);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include "crsf_decoder.hpp"
+
+// Driver side TX buffer, write() copies a frame into it and the UART interrupt sends it
+#define CRSF_TX_BUFFER_SIZE 256
+#define CRSF_TELEMETRY_FLIGHT_MODE_LENGTH 16 // Including the terminating zero
+#define CRSF_TELEMETRY_STATUS_SENSORS 4
+
+// Default frames per second of each telemetry frame, 0 disables a frame
+#define CRSF_TELEMETRY_BATTERY_RATE_HZ 2
+#define CRSF_TELEMETRY_FLIGHT_MODE_RATE_HZ 1
+#define CRSF_TELEMETRY_STATUS_RATE_HZ 1
+
+enum CrsfTelemetryFrame
+{
+    CrsfTelemetryFrame_BATTERY,     // Battery voltage from a sensor channel
+    CrsfTelemetryFrame_FLIGHT_MODE, // Board state as a short text
+    CrsfTelemetryFrame_STATUS,      // Loop timing and sensors, read by a script on the radio
+    CrsfTelemetryFrame_COUNT,
+    CrsfTelemetryFrame_NONE = CrsfTelemetryFrame_COUNT
+};
+
+/**
+ * @brief Payload of the board status frame, sent big endian like all CRSF values
+ */
+struct CrsfBoardStatus
+{
+    uint8_t status;          // BoardComputerStatus
+    uint8_t failsafeStage;   // FailsafeStage
+    uint16_t maxTickUs;      // Longest control tick in the last second
+    uint16_t tickOverruns;   // Ticks longer than the loop interval since boot, wraps
+    uint16_t sensorMillivolts[CRSF_TELEMETRY_STATUS_SENSORS];
+};
+
+struct CrsfTelemetryStats
+{
+    uint32_t framesSent;
+    uint32_t framesDropped; // Slots given up because the TX buffer had no room
+};
+
+/**
+ * @brief Decides which telemetry frame goes back to the receiver and serialises it
+ *
+ * The receiver expects telemetry right after it delivered a frame, so at most one
+ * frame is sent per received frame. Of the frames whose interval has passed the most
+ * overdue one is picked. Frames are built in a preallocated buffer and only written
+ * if the UART driver can take them whole, so the control task never waits on the line.
+ */
+class CrsfTelemetry
+{
+public:
+    CrsfTelemetry(HardwareSerial *serial, CrsfDecoder *decoder);
+
+    /**
+     * @brief Set how often each frame is sent
+     * @param ratesHz Frames per second per CrsfTelemetryFrame, 0 to disable one
+     */
+    void setRates(const uint8_t ratesHz[CrsfTelemetryFrame_COUNT]);
+
+    /**
+     * @brief Frame to fill the slot a newly received frame opened, called once per control tick
+     * @return CrsfTelemetryFrame_NONE if no slot is open or nothing is due
+     */
+    CrsfTelemetryFrame takeDueFrame(unsigned long currentTime);
+
+    /**
+     * @param decivolts Battery voltage in 0.1V
+     */
+    void sendBattery(uint16_t decivolts);
+    void sendFlightMode(const char *mode);
+    void sendBoardStatus(const CrsfBoardStatus &boardStatus);
+
+    CrsfTelemetryStats getStats() const { return stats; }
+
+private:
+    HardwareSerial *serial;
+    CrsfDecoder *decoder;
+    uint16_t intervalsMs[CrsfTelemetryFrame_COUNT]; // 0 if the frame is disabled
+    unsigned long lastSent[CrsfTelemetryFrame_COUNT];
+    uint32_t lastFrameCount; // Decoded frames when the last slot was taken
+    uint8_t txBuffer[CRSF_MAX_FRAME_SIZE];
+    CrsfTelemetryStats stats;
+
+    uint8_t *beginFrame(uint8_t type);
+    void endFrame(uint8_t *end);
+};
@@ -4,6 +4,7 @@
 #include <EEPROM.h>
 #include <ArduinoJson.h>
 #include <CRC32.h>
+#include <memory>
 #include "config_versions.hpp"
 #include "logger.hpp"
 
@@ -20,7 +21,7 @@ public:
         uint32_t timestamp; // Last update timestamp
     };
     static const uint32_t MAGIC_NUMBER = 0xB0C0FFEE; // Magic number to identify our data
-    static const uint16_t CURRENT_VERSION = 1;       // Current schema version
+    static const uint16_t CURRENT_VERSION = 2;       // Current schema version, bump with every layout change of Config
     static const size_t HEADER_SIZE = sizeof(DataHeader);
 
     bool begin(size_t dataSize)
@@ -57,16 +58,53 @@ public:
     template <typename T>
     uint32_t calculateChecksum(const T &data)
     {
-        // Create clean buffer
-        uint8_t buffer[sizeof(T)];
-        memset(buffer, 0, sizeof(T));
-        memcpy(buffer, &data, sizeof(T));
+        // Straight over the object, Config is too large for a copy on the task stacks
+        CRC32 crc;
+        crc.update(reinterpret_cast<const uint8_t *>(&data), sizeof(T));
+        return crc.finalize();
+    }
 
+    /**
+     * @brief Checksum of the data block as it is stored, read byte by byte
+     */
+    uint32_t calculateStoredChecksum(size_t dataSize)
+    {
         CRC32 crc;
-        crc.update(buffer, sizeof(T));
+        for (size_t i = 0; i < dataSize; i++)
+        {
+            crc.update(EEPROM.read(HEADER_SIZE + i));
+        }
         return crc.finalize();
     }
 
+    /**
+     * @brief Check the header and checksum of the stored data without reading it into memory
+     */
+    bool verify()
+    {
+        DataHeader header;
+        EEPROM.get(0, header);
+        if (header.magic != MAGIC_NUMBER)
+        {
+            LOG.errorf("EEPROMManager", "Invalid magic number in EEPROM. Expected: 0x%08X, Got: 0x%08X",
+                       MAGIC_NUMBER, header.magic);
+            return false;
+        }
+
+        if (HEADER_SIZE + header.dataSize > EEPROM.length())
+        {
+            LOG.errorf("EEPROMManager", "Stored data size %d does not fit the EEPROM", header.dataSize);
+            return false;
+        }
+
+        if (calculateStoredChecksum(header.dataSize) != header.checksum)
+        {
+            LOG.errorf("EEPROMManager", "Checksum verification failed");
+            return false;
+        }
+        return true;
+    }
+
     template <typename T>
     bool write(const T &data)
     {
@@ -95,9 +133,7 @@ public:
         EEPROM.put(HEADER_SIZE, data);
 
         // Verify the write by reading back
-        T readback;
-        EEPROM.get(HEADER_SIZE, readback);
-        uint32_t readbackChecksum = calculateChecksum(readback);
+        uint32_t readbackChecksum = calculateStoredChecksum(sizeof(T));
         LOG.debugf("EEPROMManager", "  Write verification checksum: 0x%08X", readbackChecksum);
 
         if (readbackChecksum != header.checksum)
@@ -111,6 +147,10 @@ public:
         return success;
     }
 
+    /**
+     * @brief Read the stored data, migrating it if it was stored by an earlier version
+     * @param data Default constructed, a migration only fills in what the stored version had
+     */
     template <typename T>
     bool read(T &data)
     {
@@ -125,40 +165,36 @@ public:
         LOG.debugf("EEPROMManager", "  Timestamp: %lu", header.timestamp);
         LOG.debugf("EEPROMManager", "  Expected data size: %d bytes", sizeof(T));
 
-        // Validate magic number
-        if (header.magic != MAGIC_NUMBER)
+        // Magic number and checksum, over the stored bytes of whatever version wrote them
+        if (!verify())
         {
-            LOG.errorf("EEPROMManager", "Invalid magic number in EEPROM. Expected: 0x%08X, Got: 0x%08X",
-                       MAGIC_NUMBER, header.magic);
             return false;
         }
 
-        // Read data
-        T readData;
-        EEPROM.get(HEADER_SIZE, readData);
-
         // Handle version migration if needed
         if (header.version != CURRENT_VERSION)
         {
-            if (!migrateData(readData, header.version))
+            if (!migrateData(data, header))
             {
                 LOG.errorf("EEPROMManager", "Migration failed");
                 return false;
             }
-        }
 
-        // Calculate checksum
-        uint32_t calculatedChecksum = calculateChecksum(readData);
+            // Store in the current layout so the migration only runs once
+            write(data);
+            return true;
+        }
 
-        if (calculatedChecksum == header.checksum)
+        if (header.dataSize != sizeof(T))
         {
-            memcpy(&data, &readData, sizeof(T));
-            LOG.infof("EEPROMManager", "EEPROM read successful");
-            return true;
+            LOG.errorf("EEPROMManager", "Stored data size %d does not match the expected %d bytes", header.dataSize, sizeof(T));
+            return false;
         }
 
-        LOG.errorf("EEPROMManager", "Checksum verification failed");
-        return false;
+        // Read straight into the caller's object
+        EEPROM.get(HEADER_SIZE, data);
+        LOG.infof("EEPROMManager", "EEPROM read successful");
+        return true;
     }
 
     bool clear()
@@ -177,25 +213,27 @@ private:
      * Returns true if migration was successful
      */
     template <typename T>
-    bool migrateData(T &data, uint16_t fromVersion)
+    bool migrateData(T &data, const DataHeader &header)
     {
-        if (fromVersion == CURRENT_VERSION)
-        {
-            return true; // No migration needed
-        }
-
-        LOG.infof("EEPROMManager", "Migrating data from version %d to %d", fromVersion, CURRENT_VERSION);
+        LOG.infof("EEPROMManager", "Migrating data from version %d to %d", header.version, CURRENT_VERSION);
 
-        while (fromVersion < CURRENT_VERSION)
+        if (header.version == 1 && header.dataSize == sizeof(ConfigVersions::ConfigV1))
         {
-            LOG.errorf("EEPROMManager", "No migration path from version %d to %d", fromVersion, CURRENT_VERSION);
-            while (true)
+            // On the heap, the task stacks only have room for the caller's copy
+            std::unique_ptr<ConfigVersions::ConfigV1> stored(new (std::nothrow) ConfigVersions::ConfigV1());
+            if (!stored)
             {
-                delay(1000);
+                LOG.error("EEPROMManager", "Not enough memory to migrate the stored data");
+                return false;
             }
+
+            EEPROM.get(HEADER_SIZE, *stored);
+            ConfigVersions::migrate(*stored, data);
+            return true;
         }
 
-        LOG.infof("EEPROMManager", "No migration path from version %d to %d", fromVersion, CURRENT_VERSION);
+        LOG.errorf("EEPROMManager", "No migration path from version %d (%d bytes) to %d",
+                   header.version, header.dataSize, CURRENT_VERSION);
         return false;
     }
 };
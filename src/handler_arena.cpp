@@ -0,0 +1,52 @@
+#include "handler_arena.hpp"
+#include "bordcomputer.hpp"
+#include "logger.hpp"
+
+HandlerArena::HandlerArena() : usedSlots(0)
+{
+}
+
+int HandlerArena::claimSlot()
+{
+    for (int i = 0; i < HANDLER_ARENA_SLOTS; i++)
+    {
+        if (!(usedSlots & (1ULL << i)))
+        {
+            usedSlots |= 1ULL << i;
+            return i;
+        }
+    }
+
+    LOG.errorf("HandlerArena", "All %d handler slots are in use", HANDLER_ARENA_SLOTS);
+    return -1;
+}
+
+uint64_t HandlerArena::slotBit(const IChannelHandler *handler) const
+{
+    const uint8_t *address = reinterpret_cast<const uint8_t *>(handler);
+    const uint8_t *first = slots[0].storage;
+    if (handler == nullptr || address < first || address >= first + sizeof(slots))
+    {
+        return 0;
+    }
+    return 1ULL << ((address - first) / sizeof(Slot));
+}
+
+void HandlerArena::destroy(IChannelHandler *handler)
+{
+    release(slotBit(handler));
+}
+
+void HandlerArena::release(uint64_t slotMask)
+{
+    slotMask &= usedSlots;
+
+    for (uint64_t pending = slotMask; pending; pending &= pending - 1)
+    {
+        // Handlers only derive from IChannelHandler, so it starts at the slot
+        int slot = __builtin_ctzll(pending);
+        reinterpret_cast<IChannelHandler *>(slots[slot].storage)->~IChannelHandler();
+    }
+
+    usedSlots &= ~slotMask;
+}
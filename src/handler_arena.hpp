@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+#include "const.hpp"
+
+class IChannelHandler;
+
+// Two sets can be alive at once while a new configuration is swapped in
+#define HANDLER_ARENA_SLOTS (2 * MAX_CHANNEL_HANDLERS)
+#define HANDLER_ARENA_SLOT_SIZE 128
+
+/**
+ * @brief Fixed pool of slots that channel handlers are placement-constructed into
+ *
+ * Reconfiguring never touches the heap, so config pushes cannot fragment the
+ * memory the web server depends on. Slots are tracked in a bitmap and a whole
+ * set of handlers is released in one step.
+ */
+class HandlerArena
+{
+public:
+    HandlerArena();
+
+    /**
+     * @brief Construct a handler in a free slot
+     * @return The handler, nullptr if all slots are in use
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        static_assert(sizeof(T) <= HANDLER_ARENA_SLOT_SIZE, "Handler does not fit into an arena slot");
+        static_assert(alignof(T) <= alignof(Slot), "Handler needs a stricter alignment than arena slots");
+
+        int slot = claimSlot();
+        if (slot < 0)
+        {
+            return nullptr;
+        }
+        return new (slots[slot].storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy a single handler and free its slot
+     */
+    void destroy(IChannelHandler *handler);
+
+    /**
+     * @brief Destroy all handlers in slotMask and free their slots at once
+     */
+    void release(uint64_t slotMask);
+
+    /**
+     * @brief Bit of the slot a handler lives in, 0 if it is not from this arena
+     */
+    uint64_t slotBit(const IChannelHandler *handler) const;
+
+    size_t used() const { return __builtin_popcountll(usedSlots); }
+    size_t capacity() const { return HANDLER_ARENA_SLOTS; }
+
+private:
+    struct Slot
+    {
+        alignas(8) uint8_t storage[HANDLER_ARENA_SLOT_SIZE];
+    };
+
+    Slot slots[HANDLER_ARENA_SLOTS];
+    uint64_t usedSlots;
+
+    int claimSlot();
+};
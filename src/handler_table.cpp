@@ -0,0 +1,81 @@
+#include "handler_table.hpp"
+#include "bordcomputer.hpp"
+
+HandlerTable::HandlerTable() : ticking(0), count(0), capacity(0)
+{
+}
+
+bool HandlerTable::reset(size_t capacity)
+{
+    count = 0;
+    ticking = 0;
+    usedChannels.clear();
+
+    if (capacity > MAX_CHANNEL_HANDLERS)
+    {
+        this->capacity = 0;
+        return false;
+    }
+
+    this->capacity = capacity;
+    return true;
+}
+
+void HandlerTable::retire(const HandlerTable *successor, HandlerArena &arena)
+{
+    uint64_t retired = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (successor == nullptr || successor->indexOf(handlers[i]) < 0)
+        {
+            retired |= arena.slotBit(handlers[i]);
+        }
+    }
+
+    arena.release(retired);
+    reset(0);
+}
+
+int HandlerTable::indexOf(const IChannelHandler *handler) const
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (handlers[i] == handler)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool HandlerTable::add(uint8_t channelIndex, IChannelHandler *handler, const FailsafeProfile &failsafe,
+                       const ConditioningProfile &conditioning)
+{
+    if (count >= capacity)
+    {
+        return false;
+    }
+
+    // Insert after the last entry of the same channel, tables are small so this stays cheap
+    size_t position = count;
+    while (position > 0 && channels[position - 1] > channelIndex)
+    {
+        channels[position] = channels[position - 1];
+        handlers[position] = handlers[position - 1];
+        failsafes[position] = failsafes[position - 1];
+        outputs[position] = outputs[position - 1];
+        this->conditioning[position] = this->conditioning[position - 1];
+        conditioners[position] = conditioners[position - 1];
+        position--;
+    }
+
+    channels[position] = channelIndex;
+    handlers[position] = handler;
+    failsafes[position] = failsafe;
+    outputs[position] = 0;
+    this->conditioning[position] = conditioning;
+    conditioners[position].reset(0);
+    count++;
+    usedChannels.set(channelIndex);
+    return true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include "const.hpp"
+#include "channels.hpp"
+#include "handler_arena.hpp"
+#include "output_conditioner.hpp"
+
+class IChannelHandler;
+
+static_assert(MAX_CHANNEL_HANDLERS <= 32, "HandlerTable::ticking has one bit per entry");
+
+/**
+ * @brief How a single output reacts to signal loss
+ */
+struct FailsafeProfile
+{
+    int value;         // Value to settle on, -1 for CHANNEL_MID
+    uint16_t holdMs;   // Keep the last received value this long after failsafe started
+    uint16_t rampRate; // Move towards value at this many µs per second, 0 to jump
+};
+
+/**
+ * @brief Channel handlers compiled into one channel-sorted struct-of-arrays table
+ *
+ * Storage is reserved for MAX_CHANNEL_HANDLERS entries, with no per-channel limit.
+ * Entries of one channel are contiguous and dispatch is a single linear sweep
+ * over the entries, which only exist for channels that are in use.
+ */
+class HandlerTable
+{
+public:
+    HandlerTable();
+
+    /**
+     * @brief Drop all entries and limit the table to capacity entries
+     * Handlers are not destroyed, that is up to retire().
+     * @return false if capacity exceeds MAX_CHANNEL_HANDLERS
+     */
+    bool reset(size_t capacity);
+
+    /**
+     * @brief Destroy every handler that is not also part of successor, then drop all entries
+     * @param successor Table that replaced this one, nullptr to destroy all handlers
+     * @param arena Arena the handlers were constructed in
+     */
+    void retire(const HandlerTable *successor, HandlerArena &arena);
+
+    /**
+     * @brief Find the entry of a handler
+     * @return Index of the entry, -1 if the handler is not in this table
+     */
+    int indexOf(const IChannelHandler *handler) const;
+
+    /**
+     * @brief Insert a handler, keeping the table sorted by channel
+     * @param channelIndex 0-based channel
+     * @return false if the table is full
+     */
+    bool add(uint8_t channelIndex, IChannelHandler *handler, const FailsafeProfile &failsafe,
+             const ConditioningProfile &conditioning);
+
+    size_t size() const { return count; }
+
+    /**
+     * @brief Channels with at least one handler
+     */
+    const ChannelMask &getUsedChannels() const { return usedChannels; }
+
+    // Struct-of-arrays storage, valid below size()
+    uint8_t channels[MAX_CHANNEL_HANDLERS];
+    IChannelHandler *handlers[MAX_CHANNEL_HANDLERS];
+    FailsafeProfile failsafes[MAX_CHANNEL_HANDLERS];
+    uint16_t outputs[MAX_CHANNEL_HANDLERS]; // Last value dispatched to each handler, 0 if none yet
+    ConditioningProfile conditioning[MAX_CHANNEL_HANDLERS];
+    OutputConditioner conditioners[MAX_CHANNEL_HANDLERS];
+    uint32_t ticking; // Bit per entry whose handler wants onTick() on the next tick
+
+private:
+    size_t count;
+    size_t capacity;
+    ChannelMask usedChannels;
+};
@@ -0,0 +1,266 @@
+#include "adc_sampler.hpp"
+#include "logger.hpp"
+#include "task_model.hpp"
+
+static_assert((SENSOR_DECIMATION & (SENSOR_DECIMATION - 1)) == 0, "SENSOR_DECIMATION must be a power of two");
+static_assert(SENSOR_DECIMATION <= 255, "SENSOR_DECIMATION must fit the block counter");
+
+// On the ESP32-C3 GPIO n is ADC1 channel n
+#define SENSOR_MAX_ADC1_PIN 4
+
+AdcSampler::AdcSampler() : configPending(false), configResult(false), running(false), overruns(0), taskHandle(NULL)
+{
+    memset(inputs, 0, sizeof(inputs));
+    memset(pendingInputs, 0, sizeof(pendingInputs));
+    memset(sensorOfAdcChannel, -1, sizeof(sensorOfAdcChannel));
+    memset(filters, 0, sizeof(filters));
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        values[i] = 0;
+        millivolts[i] = 0;
+    }
+}
+
+void AdcSampler::start()
+{
+    xTaskCreate([](void *pvParameters) -> void
+                { static_cast<AdcSampler *>(pvParameters)->taskHandler(); },
+                TASK_NAME_SAMPLING,
+                3072,
+                this,
+                TASK_PRIORITY_SAMPLING, // Below the control task, it only has to keep up with the DMA buffer
+                &taskHandle);
+    LOG.debug("AdcSampler", "ADC sampler task created");
+}
+
+bool AdcSampler::configure(const SensorInput inputs[SENSOR_CHANNEL_COUNT])
+{
+    uint32_t pins = 0;
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        if (!inputs[i].used)
+        {
+            continue;
+        }
+        if (inputs[i].pin > SENSOR_MAX_ADC1_PIN)
+        {
+            LOG.errorf("AdcSampler", "GPIO%d is not on ADC1", inputs[i].pin);
+            return false;
+        }
+        if (pins & (1UL << inputs[i].pin))
+        {
+            LOG.errorf("AdcSampler", "GPIO%d is sampled by two sensors", inputs[i].pin);
+            return false;
+        }
+        if (inputs[i].minMv == inputs[i].maxMv)
+        {
+            LOG.errorf("AdcSampler", "GPIO%d needs different voltages for the channel's ends", inputs[i].pin);
+            return false;
+        }
+        pins |= 1UL << inputs[i].pin;
+    }
+
+    memcpy(pendingInputs, inputs, sizeof(pendingInputs));
+    if (taskHandle == NULL)
+    {
+        // Task not running yet, nobody else is touching the ADC
+        return apply();
+    }
+
+    // The task owns the ADC, it switches over between two reads
+    configPending = true;
+    xTaskNotifyGive(taskHandle);
+    while (configPending.load())
+    {
+        vTaskDelay(1);
+    }
+    return configResult;
+}
+
+void AdcSampler::stop()
+{
+    if (running)
+    {
+        adc_digi_stop();
+        adc_digi_deinitialize();
+        running = false;
+    }
+}
+
+bool AdcSampler::apply()
+{
+    stop();
+    memcpy(inputs, pendingInputs, sizeof(inputs));
+    memset(sensorOfAdcChannel, -1, sizeof(sensorOfAdcChannel));
+    memset(filters, 0, sizeof(filters));
+
+    adc_digi_pattern_config_t pattern[SENSOR_CHANNEL_COUNT] = {};
+    uint8_t patternLength = 0;
+    uint32_t channelMask = 0;
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        values[i] = 0;
+        millivolts[i] = 0;
+        if (!inputs[i].used)
+        {
+            continue;
+        }
+
+        sensorOfAdcChannel[inputs[i].pin] = i;
+        channelMask |= 1UL << inputs[i].pin;
+        pattern[patternLength].atten = ADC_ATTEN_DB_11;
+        pattern[patternLength].channel = inputs[i].pin;
+        pattern[patternLength].unit = 0; // ADC1
+        pattern[patternLength].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        patternLength++;
+    }
+
+    if (patternLength == 0)
+    {
+        LOG.debug("AdcSampler", "No sensors, ADC stopped");
+        return true;
+    }
+
+    // Uses the eFuse calibration where there is one, 11dB covers up to about 2.5V
+    esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &calibration);
+
+    // One filter step per sensor every SENSOR_DECIMATION turns of the pattern
+    uint32_t stepUs = (uint64_t)SENSOR_DECIMATION * patternLength * 1000000 / SENSOR_SAMPLE_RATE_HZ;
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        uint32_t filterUs = (uint32_t)inputs[i].filterMs * 1000;
+        filters[i].alphaQ16 = ((uint64_t)stepUs << 16) / (filterUs + stepUs);
+    }
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = SENSOR_BUFFER_BYTES;
+    initConfig.conv_num_each_intr = SENSOR_READ_BYTES;
+    initConfig.adc1_chan_mask = channelMask;
+    initConfig.adc2_chan_mask = 0;
+    esp_err_t result = adc_digi_initialize(&initConfig);
+    if (result != ESP_OK)
+    {
+        LOG.errorf("AdcSampler", "ADC DMA cannot be set up: %s", esp_err_to_name(result));
+        return false;
+    }
+
+    adc_digi_configuration_t controllerConfig = {};
+    controllerConfig.conv_limit_en = false;
+    controllerConfig.conv_limit_num = 250;
+    controllerConfig.pattern_num = patternLength;
+    controllerConfig.adc_pattern = pattern;
+    controllerConfig.sample_freq_hz = SENSOR_SAMPLE_RATE_HZ;
+    controllerConfig.conv_mode = ADC_CONV_ALTER_UNIT; // The only mode the ESP32-C3 DMA supports
+    controllerConfig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    result = adc_digi_controller_configure(&controllerConfig);
+    if (result == ESP_OK)
+    {
+        result = adc_digi_start();
+    }
+    if (result != ESP_OK)
+    {
+        LOG.errorf("AdcSampler", "ADC DMA cannot be started: %s", esp_err_to_name(result));
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    running = true;
+    LOG.infof("AdcSampler", "Sampling %d pins at %dHz, a filter step every %luus", patternLength,
+              SENSOR_SAMPLE_RATE_HZ / patternLength, stepUs);
+    return true;
+}
+
+void AdcSampler::publish(uint16_t *channelValues, ChannelMask &changed) const
+{
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        uint16_t value = values[i];
+        uint8_t channel = FIRST_SENSOR_CHANNEL - 1 + i;
+        if (value != 0 && channelValues[channel] != value)
+        {
+            channelValues[channel] = value;
+            changed.set(channel);
+        }
+    }
+}
+
+void AdcSampler::process(const uint8_t *data, uint32_t length)
+{
+    for (uint32_t offset = 0; offset + sizeof(adc_digi_output_data_t) <= length; offset += sizeof(adc_digi_output_data_t))
+    {
+        const adc_digi_output_data_t *conversion = reinterpret_cast<const adc_digi_output_data_t *>(data + offset);
+        if (conversion->type2.unit != 0)
+        {
+            continue;
+        }
+
+        int8_t sensor = sensorOfAdcChannel[conversion->type2.channel];
+        if (sensor < 0)
+        {
+            continue;
+        }
+
+        Filter &filter = filters[sensor];
+        filter.sum += conversion->type2.data;
+        if (++filter.count < SENSOR_DECIMATION)
+        {
+            continue;
+        }
+
+        // Calibrate the block average, then low pass it
+        uint32_t raw = filter.sum / SENSOR_DECIMATION;
+        filter.sum = 0;
+        filter.count = 0;
+        int32_t inputQ16 = (int32_t)esp_adc_cal_raw_to_voltage(raw, &calibration) << 16;
+        if (filter.primed)
+        {
+            filter.stateQ16 += ((int64_t)(inputQ16 - filter.stateQ16) * filter.alphaQ16) >> 16;
+        }
+        else
+        {
+            filter.stateQ16 = inputQ16;
+            filter.primed = true;
+        }
+
+        const SensorInput &input = inputs[sensor];
+        int32_t mv = (filter.stateQ16 + (1 << 15)) >> 16;
+        int32_t value = CHANNEL_MIN + (mv - input.minMv) * (CHANNEL_MAX - CHANNEL_MIN) / ((int32_t)input.maxMv - input.minMv);
+        millivolts[sensor] = mv;
+        values[sensor] = constrain(value, CHANNEL_MIN, CHANNEL_MAX);
+    }
+}
+
+void AdcSampler::taskHandler()
+{
+    uint8_t buffer[SENSOR_READ_BYTES];
+
+    while (true)
+    {
+        if (configPending.load())
+        {
+            configResult = apply();
+            configPending = false;
+        }
+
+        if (!running)
+        {
+            // Nothing to sample, sleep until configure() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        uint32_t length = 0;
+        esp_err_t result = adc_digi_read_bytes(buffer, sizeof(buffer), &length, SENSOR_READ_TIMEOUT_MS);
+        if (result == ESP_ERR_INVALID_STATE)
+        {
+            // The buffer ran full while we were away, what was read is still valid
+            overruns++;
+        }
+        else if (result != ESP_OK)
+        {
+            continue;
+        }
+
+        process(buffer, length);
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#include "channels.hpp"
+
+// Conversions per second shared by all sensors, the ESP32-C3 DMA runs at 611Hz at the least
+#define SENSOR_SAMPLE_RATE_HZ 2000
+// Conversions of one sensor averaged into one filter step, a power of two
+#define SENSOR_DECIMATION 16
+// DMA results handed over per read, and what the driver buffers while the task is late
+#define SENSOR_READ_BYTES 256
+#define SENSOR_BUFFER_BYTES 1024
+// The task looks for a new configuration at least this often
+#define SENSOR_READ_TIMEOUT_MS 50
+
+/**
+ * @brief What a sensor channel samples and how it is scaled
+ */
+struct SensorInput
+{
+    bool used;
+    uint8_t pin;       // GPIO on ADC1
+    uint16_t minMv;    // Pin voltage published as CHANNEL_MIN
+    uint16_t maxMv;    // Pin voltage published as CHANNEL_MAX
+    uint16_t filterMs; // Time constant of the low pass, 0 for none
+};
+
+/**
+ * @brief Samples the sensor pins with the ADC's DMA and publishes them as sensor channels
+ *
+ * The ADC converts the configured pins round robin into a DMA buffer on its own.
+ * A low priority task drains it, averages SENSOR_DECIMATION conversions per pin,
+ * converts the average to millivolts and runs it through a first order low pass
+ * in Q16 fixed point. The control task only picks up the latest filtered values,
+ * it never waits for the ADC.
+ */
+class AdcSampler
+{
+public:
+    AdcSampler();
+
+    /**
+     * @brief Create the sampler task
+     */
+    void start();
+
+    /**
+     * @brief Replace what is sampled, sensors not used any more stop being published
+     * Blocks until the sampler task restarted the ADC.
+     * @param inputs One entry per sensor channel, FIRST_SENSOR_CHANNEL onwards
+     * @return false if a pin is not on ADC1, is used twice or the ADC could not be started
+     */
+    bool configure(const SensorInput inputs[SENSOR_CHANNEL_COUNT]);
+
+    /**
+     * @brief Copy the latest filtered values into the sensor channels, called by the control task
+     * @param channelValues Values of all CHANNEL_COUNT channels
+     * @param changed Gets the bits of sensor channels whose value changed
+     */
+    void publish(uint16_t *channelValues, ChannelMask &changed) const;
+
+    /**
+     * @brief Filtered pin voltage of a sensor, 0 before its first reading
+     */
+    uint16_t getMillivolts(uint8_t sensor) const { return millivolts[sensor]; }
+
+    /**
+     * @brief Reads that found the DMA buffer full, conversions were lost
+     */
+    uint32_t getOverruns() const { return overruns; }
+
+private:
+    struct Filter
+    {
+        uint32_t sum;     // Conversions of the current block
+        uint8_t count;
+        bool primed;      // state holds a reading
+        int32_t stateQ16; // Filtered millivolts, Q16
+        uint32_t alphaQ16;
+    };
+
+    SensorInput inputs[SENSOR_CHANNEL_COUNT];
+    SensorInput pendingInputs[SENSOR_CHANNEL_COUNT];
+    std::atomic<bool> configPending;
+    bool configResult;
+    bool running;
+    int8_t sensorOfAdcChannel[8]; // By the 3 bit channel of a DMA result, -1 if not sampled
+    Filter filters[SENSOR_CHANNEL_COUNT];
+    esp_adc_cal_characteristics_t calibration;
+
+    // Written by the sampler task, read by the control task and telemetry
+    volatile uint16_t values[SENSOR_CHANNEL_COUNT]; // Channel value, 0 before the first reading
+    volatile uint16_t millivolts[SENSOR_CHANNEL_COUNT];
+    volatile uint32_t overruns;
+    TaskHandle_t taskHandle;
+
+    bool apply();
+    void stop();
+    void process(const uint8_t *data, uint32_t length);
+    void taskHandler();
+};
@@ -0,0 +1,90 @@
+#include "ibus_decoder.hpp"
+
+// Frame length, then the servo command
+#define IBUS_HEADER_0 0x20
+#define IBUS_HEADER_1 0x40
+#define IBUS_CHECKSUM_OFFSET (IBUS_FRAME_SIZE - 2)
+
+IbusDecoder::IbusDecoder() : port(nullptr), rxLength(0)
+{
+}
+
+void IbusDecoder::begin(Stream &port, uint16_t *channelValues)
+{
+    reset(channelValues);
+    this->port = &port;
+    this->rxLength = 0;
+}
+
+void IbusDecoder::update()
+{
+    if (!port)
+    {
+        return;
+    }
+
+    uint32_t startCycles = ESP.getCycleCount();
+
+    int available;
+    while ((available = port->available()) > 0)
+    {
+        size_t space = sizeof(rxBuffer) - rxLength;
+        size_t count = min((size_t)available, space);
+        rxLength += port->readBytes(rxBuffer + rxLength, count);
+
+        size_t consumed = parse();
+        if (consumed > 0 && consumed < rxLength)
+        {
+            memmove(rxBuffer, rxBuffer + consumed, rxLength - consumed);
+        }
+        rxLength -= consumed;
+    }
+
+    stats.lastUpdateCycles = ESP.getCycleCount() - startCycles;
+}
+
+size_t IbusDecoder::parse()
+{
+    size_t position = 0;
+
+    while (rxLength - position >= 2)
+    {
+        const uint8_t *frame = rxBuffer + position;
+        if (frame[0] != IBUS_HEADER_0 || frame[1] != IBUS_HEADER_1)
+        {
+            position++;
+            stats.bytesDiscarded++;
+            continue;
+        }
+
+        if (rxLength - position < IBUS_FRAME_SIZE)
+        {
+            break; // Wait for the rest of the frame
+        }
+
+        uint16_t checksum = 0xFFFF;
+        for (uint8_t i = 0; i < IBUS_CHECKSUM_OFFSET; i++)
+        {
+            checksum -= frame[i];
+        }
+        if (checksum != (frame[IBUS_CHECKSUM_OFFSET] | (frame[IBUS_CHECKSUM_OFFSET + 1] << 8)))
+        {
+            position++;
+            stats.crcErrors++;
+            stats.bytesDiscarded++;
+            continue;
+        }
+
+        // Some receivers put channels 15 to 18 into the high nibbles, those are not decoded
+        const uint8_t *payload = frame + 2;
+        for (uint8_t i = 0; i < IBUS_CHANNEL_COUNT; i++)
+        {
+            setChannel(i, (payload[i * 2] | (payload[i * 2 + 1] << 8)) & 0x0FFF);
+        }
+        channelsReceived();
+        stats.framesDecoded++;
+        position += IBUS_FRAME_SIZE;
+    }
+
+    return position;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+#include "input_decoder.hpp"
+
+#define IBUS_BAUDRATE 115200
+#define IBUS_FRAME_SIZE 32
+#define IBUS_CHANNEL_COUNT 14
+#define IBUS_RX_BUFFER_SIZE 128
+
+/**
+ * @brief Parses iBUS servo frames in place from the receive buffer
+ *
+ * Same bulk read and in place parsing as CRSF. A frame is the two header bytes,
+ * 14 little endian channels in µs and a checksum that is 0xFFFF minus the sum of
+ * all bytes before it.
+ */
+class IbusDecoder : public InputDecoder
+{
+public:
+    IbusDecoder();
+
+    /**
+     * @param port Stream the iBUS receiver's servo port is connected to
+     * @param channelValues Array of INPUT_MAX_CHANNELS values (in µs), the last two are left alone
+     */
+    void begin(Stream &port, uint16_t *channelValues);
+
+    void update() override;
+
+private:
+    Stream *port;
+    uint8_t rxBuffer[IBUS_RX_BUFFER_SIZE];
+    size_t rxLength;
+
+    size_t parse();
+};
@@ -0,0 +1,62 @@
+#include "input_decoder.hpp"
+
+static const char *const PROTOCOL_NAMES[InputProtocol_COUNT] = {"crsf", "sbus", "ibus", "ppm"};
+
+const char *inputProtocolName(InputProtocol protocol)
+{
+    return protocol < InputProtocol_COUNT ? PROTOCOL_NAMES[protocol] : "unknown";
+}
+
+InputProtocol inputProtocolFromName(const char *name)
+{
+    for (uint8_t i = 0; i < InputProtocol_COUNT; i++)
+    {
+        if (strcmp(name, PROTOCOL_NAMES[i]) == 0)
+        {
+            return (InputProtocol)i;
+        }
+    }
+    return InputProtocol_COUNT;
+}
+
+InputDecoder::InputDecoder()
+    : channelValues(nullptr), changedChannels(0), lastChannelsTime(0), lastChannelsMicros(0)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+void InputDecoder::reset(uint16_t *channelValues)
+{
+    this->channelValues = channelValues;
+    this->changedChannels = 0;
+    this->lastChannelsTime = 0;
+    this->lastChannelsMicros = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void InputDecoder::unpackChannels11(const uint8_t *payload)
+{
+    // Every channel spans at most three bytes, the last one reads the byte after the payload
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        const uint16_t bitOffset = i * 11;
+        const uint8_t *bytes = payload + (bitOffset >> 3);
+        uint32_t bits = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+        uint16_t ticks = (bits >> (bitOffset & 7)) & 0x7FF;
+
+        // 172..992..1811 ticks -> 988..1500..2012us
+        setChannel(i, 880 + ((ticks * 5) >> 3));
+    }
+}
+
+void InputDecoder::channelsReceived()
+{
+    uint32_t now = micros();
+    if (lastChannelsMicros != 0)
+    {
+        stats.lastFrameGapUs = now - lastChannelsMicros;
+        stats.maxFrameGapUs = max(stats.maxFrameGapUs, stats.lastFrameGapUs);
+    }
+    lastChannelsMicros = now;
+    lastChannelsTime = millis();
+}
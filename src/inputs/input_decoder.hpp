@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Arduino.h>
+#include "channels.hpp"
+
+// Receivers run at least this many channels, decoders never deliver more
+#define INPUT_MAX_CHANNELS HIGHEST_CHANNEL_NUMBER
+
+enum InputProtocol
+{
+    InputProtocol_CRSF, // UART, with link statistics and telemetry
+    InputProtocol_SBUS, // Inverted UART at 100000 baud 8E2
+    InputProtocol_IBUS, // UART at 115200 baud 8N1
+    InputProtocol_PPM,  // Pulse train captured by the RMT
+    InputProtocol_COUNT
+};
+
+/**
+ * @brief Config and log name of a protocol, "crsf", "sbus", "ibus" or "ppm"
+ */
+const char *inputProtocolName(InputProtocol protocol);
+
+/**
+ * @brief Protocol with the given name
+ * @return InputProtocol_COUNT if the name is unknown
+ */
+InputProtocol inputProtocolFromName(const char *name);
+
+struct InputDecoderStats
+{
+    uint32_t framesDecoded;
+    uint32_t crcErrors;        // Frames failing their checksum, or PPM frames with pulses out of range
+    uint32_t bytesDiscarded;   // Bytes skipped while looking for a frame start, 0 for PPM
+    uint32_t lastUpdateCycles; // CPU cycles spent in the last update() call
+    uint32_t lastFrameGapUs;   // Time between the last two RC channel frames
+    uint32_t maxFrameGapUs;
+};
+
+struct CrsfLinkStatistics;
+
+/**
+ * @brief Turns what a receiver sends into RC channel values
+ *
+ * Backends own the parsing, the base keeps what the control task looks at: the
+ * channel array frames are decoded into, which channels changed and when the last
+ * valid frame arrived. Frames a receiver marks as failsafe are not valid frames,
+ * so the board's own failsafe starts after the configured frame gap.
+ * Only the control task calls update() and the getters.
+ */
+class InputDecoder
+{
+public:
+    virtual ~InputDecoder() = default;
+
+    /**
+     * @brief Decode everything that was received since the last call
+     */
+    virtual void update() = 0;
+
+    /**
+     * @brief Get the link quality the receiver reported
+     * @return false if the protocol has none or it is outdated
+     */
+    virtual bool getLinkStatistics(CrsfLinkStatistics &linkStatistics) const { return false; }
+
+    /**
+     * @brief millis() of the last RC channel frame, 0 if none was received yet
+     */
+    unsigned long getLastChannelsTime() const { return lastChannelsTime; }
+
+    /**
+     * @brief Get and reset the bitmask of channels whose value changed since the last call
+     * @return Bit n is set if channel n (0-based) changed
+     */
+    uint16_t takeChangedChannels()
+    {
+        uint16_t changed = changedChannels;
+        changedChannels = 0;
+        return changed;
+    }
+
+    InputDecoderStats getStats() const { return stats; }
+
+protected:
+    InputDecoder();
+
+    uint16_t *channelValues; // INPUT_MAX_CHANNELS values in µs
+    uint16_t changedChannels;
+    unsigned long lastChannelsTime;
+    uint32_t lastChannelsMicros;
+    InputDecoderStats stats;
+
+    /**
+     * @brief Forget what the previous receiver sent and decode into channelValues from now on
+     */
+    void reset(uint16_t *channelValues);
+
+    /**
+     * @brief Store a channel limited to the board's range, remembering if it changed
+     */
+    inline void setChannel(uint8_t index, uint16_t value)
+    {
+        value = value < CHANNEL_MIN ? CHANNEL_MIN : value;
+        value = value > CHANNEL_MAX ? CHANNEL_MAX : value;
+        changedChannels |= (uint16_t)(value != channelValues[index]) << index;
+        channelValues[index] = value;
+    }
+
+    /**
+     * @brief Unpack 16 channels of 11 bits packed LSB first, as CRSF and SBUS send them
+     * Reads one byte past the 22 payload bytes.
+     */
+    void unpackChannels11(const uint8_t *payload);
+
+    /**
+     * @brief Record that a complete RC channel frame was stored
+     */
+    void channelsReceived();
+};
@@ -0,0 +1,191 @@
+#include "ppm_decoder.hpp"
+#include "logger.hpp"
+#include "task_model.hpp"
+
+PpmDecoder::PpmDecoder()
+    : lock(portMUX_INITIALIZER_UNLOCKED), capturedCount(0), capturedFrames(0), pickedUpFrames(0), frameErrors(0),
+      capturing(false), stopRequested(false), ringBuffer(NULL), taskHandle(NULL)
+{
+    memset(captured, 0, sizeof(captured));
+}
+
+bool PpmDecoder::begin(uint8_t pin, uint16_t *channelValues, std::function<void()> onFrame)
+{
+    end();
+    reset(channelValues);
+    this->onFrame = onFrame;
+    capturedFrames = 0;
+    pickedUpFrames = 0;
+    frameErrors = 0;
+
+    // 1µs ticks, glitches shorter than about a microsecond are filtered out
+    rmt_config_t config = RMT_DEFAULT_CONFIG_RX((gpio_num_t)pin, PPM_RMT_CHANNEL);
+    config.rx_config.idle_threshold = PPM_SYNC_GAP_US;
+    esp_err_t result = rmt_config(&config);
+    if (result == ESP_OK)
+    {
+        result = rmt_driver_install(PPM_RMT_CHANNEL, PPM_RX_BUFFER_SIZE, 0);
+    }
+    if (result == ESP_OK)
+    {
+        result = rmt_get_ringbuf_handle(PPM_RMT_CHANNEL, &ringBuffer);
+        if (result == ESP_OK)
+        {
+            result = rmt_rx_start(PPM_RMT_CHANNEL, true);
+        }
+        if (result != ESP_OK)
+        {
+            rmt_driver_uninstall(PPM_RMT_CHANNEL);
+        }
+    }
+    if (result != ESP_OK)
+    {
+        LOG.errorf("PpmDecoder", "RMT cannot capture GPIO%d: %s", pin, esp_err_to_name(result));
+        return false;
+    }
+
+    capturing = true;
+    if (taskHandle == NULL)
+    {
+        xTaskCreate([](void *pvParameters) -> void
+                    { static_cast<PpmDecoder *>(pvParameters)->taskHandler(); },
+                    TASK_NAME_CAPTURE,
+                    2048,
+                    this,
+                    TASK_PRIORITY_CONTROL, // Same tier as the control task, it only passes frames on
+                    &taskHandle);
+    }
+    else
+    {
+        xTaskNotifyGive(taskHandle);
+    }
+
+    LOG.infof("PpmDecoder", "Capturing PPM on GPIO%d", pin);
+    return true;
+}
+
+void PpmDecoder::end()
+{
+    if (!capturing.load())
+    {
+        return;
+    }
+
+    // The capture task may be inside the ring buffer, it lets go within PPM_RECEIVE_TIMEOUT_MS
+    stopRequested = true;
+    while (capturing.load())
+    {
+        vTaskDelay(1);
+    }
+    rmt_rx_stop(PPM_RMT_CHANNEL);
+    rmt_driver_uninstall(PPM_RMT_CHANNEL);
+    ringBuffer = NULL;
+}
+
+void PpmDecoder::update()
+{
+    uint32_t startCycles = ESP.getCycleCount();
+
+    portENTER_CRITICAL(&lock);
+    bool fresh = capturedFrames != pickedUpFrames;
+    pickedUpFrames = capturedFrames;
+    uint16_t widths[INPUT_MAX_CHANNELS];
+    uint8_t count = capturedCount;
+    memcpy(widths, captured, sizeof(widths));
+    portEXIT_CRITICAL(&lock);
+
+    stats.framesDecoded = pickedUpFrames;
+    stats.crcErrors = frameErrors;
+    if (fresh)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            setChannel(i, widths[i]);
+        }
+        channelsReceived();
+    }
+
+    stats.lastUpdateCycles = ESP.getCycleCount() - startCycles;
+}
+
+uint8_t PpmDecoder::decodeFrame(const rmt_item32_t *items, size_t count, uint16_t *widths)
+{
+    // Durations alternate between pulse and gap, starting with the first pulse after the
+    // sync gap. The last pulse only closes the final channel, a zero duration ends the frame.
+    uint8_t channels = 0;
+    uint32_t pulseUs = 0;
+    bool pulsePending = false;
+    for (size_t i = 0; i < count * 2; i++)
+    {
+        const rmt_item32_t &item = items[i >> 1];
+        uint32_t durationUs = (i & 1) ? item.duration1 : item.duration0;
+        if (durationUs == 0)
+        {
+            break;
+        }
+
+        if (!pulsePending)
+        {
+            pulseUs = durationUs;
+            pulsePending = true;
+            continue;
+        }
+
+        uint32_t widthUs = pulseUs + durationUs;
+        if (channels == INPUT_MAX_CHANNELS || widthUs < PPM_MIN_CHANNEL_US || widthUs > PPM_MAX_CHANNEL_US)
+        {
+            return 0;
+        }
+        widths[channels++] = widthUs;
+        pulsePending = false;
+    }
+
+    return channels >= PPM_MIN_CHANNELS ? channels : 0;
+}
+
+void PpmDecoder::taskHandler()
+{
+    uint16_t widths[INPUT_MAX_CHANNELS];
+
+    while (true)
+    {
+        if (stopRequested.load())
+        {
+            stopRequested = false;
+            capturing = false;
+        }
+
+        if (!capturing.load())
+        {
+            // Sleep until begin() starts the next capture
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        size_t length = 0;
+        rmt_item32_t *items = (rmt_item32_t *)xRingbufferReceive(ringBuffer, &length, pdMS_TO_TICKS(PPM_RECEIVE_TIMEOUT_MS));
+        if (items == NULL)
+        {
+            continue;
+        }
+
+        uint8_t count = decodeFrame(items, length / sizeof(rmt_item32_t), widths);
+        vRingbufferReturnItem(ringBuffer, items);
+        if (count == 0)
+        {
+            frameErrors++;
+            continue;
+        }
+
+        portENTER_CRITICAL(&lock);
+        memcpy(captured, widths, count * sizeof(uint16_t));
+        capturedCount = count;
+        capturedFrames++;
+        portEXIT_CRITICAL(&lock);
+
+        if (onFrame)
+        {
+            onFrame();
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <driver/rmt.h>
+#include "input_decoder.hpp"
+
+// First receive channel of the ESP32-C3, the transmit channels are left to light bars
+#define PPM_RMT_CHANNEL RMT_CHANNEL_2
+// Constant level that ends a frame, longer than any channel and shorter than every sync gap
+#define PPM_SYNC_GAP_US 2500
+// Channel widths a frame may contain, anything else is noise or a different signal
+#define PPM_MIN_CHANNEL_US 700
+#define PPM_MAX_CHANNEL_US 2300
+#define PPM_MIN_CHANNELS 4
+// Captured frames the RMT driver can hold for the capture task
+#define PPM_RX_BUFFER_SIZE 512
+// The capture task checks for end() at least this often
+#define PPM_RECEIVE_TIMEOUT_MS 50
+
+/**
+ * @brief Decodes a PPM pulse train captured by the RMT
+ *
+ * The RMT timestamps every edge on its own and closes a frame when the line stayed
+ * at one level for PPM_SYNC_GAP_US, so the sync gap is found in hardware and edge
+ * timing does not depend on interrupt latency. A small task takes each frame from
+ * the driver's ring buffer, turns it into channel widths and reports it through the
+ * frame callback, the control task picks up the latest widths in update().
+ * Either signal polarity works, a channel is always one pulse plus the gap after it.
+ */
+class PpmDecoder : public InputDecoder
+{
+public:
+    PpmDecoder();
+
+    /**
+     * @brief Start capturing on pin
+     * @param channelValues Array of INPUT_MAX_CHANNELS values (in µs) that frames are stored in
+     * @param onFrame Called from the capture task after every valid frame
+     * @return false if the RMT channel could not be set up
+     */
+    bool begin(uint8_t pin, uint16_t *channelValues, std::function<void()> onFrame);
+
+    /**
+     * @brief Stop capturing and release the RMT channel, waits for the capture task to let go of it
+     */
+    void end();
+
+    void update() override;
+
+    /**
+     * @brief Turn one captured frame into channel widths
+     * @param widths Gets up to INPUT_MAX_CHANNELS widths in µs
+     * @return Number of channels, 0 if the frame is not a plausible PPM frame
+     */
+    static uint8_t decodeFrame(const rmt_item32_t *items, size_t count, uint16_t *widths);
+
+private:
+    portMUX_TYPE lock;
+    uint16_t captured[INPUT_MAX_CHANNELS]; // Latest frame, written by the capture task under lock
+    uint8_t capturedCount;
+    uint32_t capturedFrames;
+    uint32_t pickedUpFrames;
+    volatile uint32_t frameErrors;
+    std::atomic<bool> capturing;
+    std::atomic<bool> stopRequested;
+    RingbufHandle_t ringBuffer;
+    std::function<void()> onFrame;
+    TaskHandle_t taskHandle;
+
+    void taskHandler();
+};
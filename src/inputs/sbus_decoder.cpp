@@ -0,0 +1,83 @@
+#include "sbus_decoder.hpp"
+
+#define SBUS_START_BYTE 0x0F
+#define SBUS_FLAGS_OFFSET 23
+#define SBUS_FLAG_FAILSAFE 0x08
+
+static inline bool isEndByte(uint8_t value)
+{
+    // 0x00 for SBUS, SBUS2 receivers cycle the high nibble through their telemetry slots
+    return value == 0x00 || (value & 0x0F) == 0x04;
+}
+
+SbusDecoder::SbusDecoder() : port(nullptr), rxLength(0), failsafeFrames(0)
+{
+}
+
+void SbusDecoder::begin(Stream &port, uint16_t *channelValues)
+{
+    reset(channelValues);
+    this->port = &port;
+    this->rxLength = 0;
+    this->failsafeFrames = 0;
+}
+
+void SbusDecoder::update()
+{
+    if (!port)
+    {
+        return;
+    }
+
+    uint32_t startCycles = ESP.getCycleCount();
+
+    int available;
+    while ((available = port->available()) > 0)
+    {
+        size_t space = sizeof(rxBuffer) - rxLength;
+        size_t count = min((size_t)available, space);
+        rxLength += port->readBytes(rxBuffer + rxLength, count);
+
+        size_t consumed = parse();
+        if (consumed > 0 && consumed < rxLength)
+        {
+            memmove(rxBuffer, rxBuffer + consumed, rxLength - consumed);
+        }
+        rxLength -= consumed;
+    }
+
+    stats.lastUpdateCycles = ESP.getCycleCount() - startCycles;
+}
+
+size_t SbusDecoder::parse()
+{
+    size_t position = 0;
+
+    while (rxLength - position >= SBUS_FRAME_SIZE)
+    {
+        const uint8_t *frame = rxBuffer + position;
+        if (frame[0] != SBUS_START_BYTE || !isEndByte(frame[SBUS_FRAME_SIZE - 1]))
+        {
+            // Channel data can contain the start byte, only a matching end byte confirms it
+            position++;
+            stats.bytesDiscarded++;
+            continue;
+        }
+
+        stats.framesDecoded++;
+        position += SBUS_FRAME_SIZE;
+
+        if (frame[SBUS_FLAGS_OFFSET] & SBUS_FLAG_FAILSAFE)
+        {
+            // The receiver repeats old or preset values, let our own failsafe take over
+            failsafeFrames++;
+            continue;
+        }
+
+        // The last channel reads into the flags byte
+        unpackChannels11(frame + 1);
+        channelsReceived();
+    }
+
+    return position;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+#include "input_decoder.hpp"
+
+#define SBUS_BAUDRATE 100000
+#define SBUS_FRAME_SIZE 25
+#define SBUS_RX_BUFFER_SIZE 128
+
+/**
+ * @brief Parses SBUS frames in place from the receive buffer
+ *
+ * The UART does the inverting and the 8E2 framing, bytes are pulled in one bulk
+ * read per update() like with CRSF. SBUS has no checksum, a frame counts when its
+ * start byte and end byte are where they belong. Frames with the failsafe flag set
+ * carry no valid channels and are only counted.
+ */
+class SbusDecoder : public InputDecoder
+{
+public:
+    SbusDecoder();
+
+    /**
+     * @param port Stream the SBUS receiver is connected to
+     * @param channelValues Array of INPUT_MAX_CHANNELS values (in µs) that frames are unpacked into
+     */
+    void begin(Stream &port, uint16_t *channelValues);
+
+    void update() override;
+
+    /**
+     * @brief Frames the receiver flagged as failsafe
+     */
+    uint32_t getFailsafeFrames() const { return failsafeFrames; }
+
+private:
+    Stream *port;
+    uint8_t rxBuffer[SBUS_RX_BUFFER_SIZE];
+    size_t rxLength;
+    uint32_t failsafeFrames;
+
+    size_t parse();
+};
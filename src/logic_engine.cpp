@@ -0,0 +1,435 @@
+#include "logic_engine.hpp"
+#include "logger.hpp"
+#include <ctype.h>
+
+namespace
+{
+    // Recursive descent compiler, tracks the stack depth the bytecode will reach
+    struct LogicCompiler
+    {
+        const char *position;
+        LogicProgram &program;
+        const char *error;
+        uint8_t depth;
+        uint8_t instructions;
+
+        LogicCompiler(const char *source, LogicProgram &program)
+            : position(source), program(program), error(nullptr), depth(0), instructions(0) {}
+
+        bool fail(const char *message)
+        {
+            if (error == nullptr)
+            {
+                error = message;
+            }
+            return false;
+        }
+
+        void skipSpace()
+        {
+            while (isspace((unsigned char)*position))
+            {
+                position++;
+            }
+        }
+
+        bool matchSymbol(const char *symbol)
+        {
+            skipSpace();
+            size_t length = strlen(symbol);
+            if (strncmp(position, symbol, length) != 0)
+            {
+                return false;
+            }
+            position += length;
+            return true;
+        }
+
+        bool matchKeyword(const char *keyword)
+        {
+            skipSpace();
+            size_t length = strlen(keyword);
+            if (strncasecmp(position, keyword, length) != 0 || isalnum((unsigned char)position[length]))
+            {
+                return false;
+            }
+            position += length;
+            return true;
+        }
+
+        bool emitByte(uint8_t value)
+        {
+            if (program.length >= LOGIC_MAX_CODE)
+            {
+                return fail("expression too long");
+            }
+            program.code[program.length++] = value;
+            return true;
+        }
+
+        bool emit(LogicOpcode opcode, int stackEffect)
+        {
+            if (++instructions > LOGIC_MAX_INSTRUCTIONS)
+            {
+                return fail("too many instructions");
+            }
+            depth += stackEffect;
+            if (depth > LOGIC_MAX_STACK)
+            {
+                return fail("expression nested too deep");
+            }
+            return emitByte(opcode);
+        }
+
+        bool parseNumber(int32_t &value)
+        {
+            skipSpace();
+            char *end;
+            value = strtol(position, &end, 10);
+            if (end == position)
+            {
+                return fail("number expected");
+            }
+            position = end;
+            return true;
+        }
+
+        bool parseChannel(uint8_t &index)
+        {
+            int32_t channel;
+            skipSpace();
+            if (strncasecmp(position, "ch", 2) != 0)
+            {
+                return fail("channel expected");
+            }
+            position += 2;
+            if (!parseNumber(channel) || channel < 1 || channel > CHANNEL_COUNT)
+            {
+                return fail("invalid channel");
+            }
+            index = channel - 1;
+            return true;
+        }
+
+        bool parseTimer(LogicOpcode opcode)
+        {
+            int32_t ms;
+            if (!parseOr() || !matchSymbol(",") || !parseNumber(ms) || !matchSymbol(")"))
+            {
+                return fail("expected (condition, ms)");
+            }
+            if (ms < 0 || ms > UINT16_MAX)
+            {
+                return fail("timer out of range");
+            }
+            if (program.timerCount >= LOGIC_MAX_TIMERS)
+            {
+                return fail("too many timers");
+            }
+            return emit(opcode, 0) && emitByte(program.timerCount++) && emitByte(ms & 0xFF) && emitByte(ms >> 8);
+        }
+
+        bool parseOperand()
+        {
+            uint8_t index;
+            int32_t value;
+
+            if (matchSymbol("("))
+            {
+                return parseOr() && (matchSymbol(")") || fail("')' expected"));
+            }
+            if (matchKeyword("failsafe"))
+            {
+                return emit(LogicOpcode_FAILSAFE, 1);
+            }
+            if (matchKeyword("true"))
+            {
+                return emit(LogicOpcode_CONST, 1) && emitByte(1) && emitByte(0);
+            }
+            if (matchKeyword("false"))
+            {
+                return emit(LogicOpcode_CONST, 1) && emitByte(0) && emitByte(0);
+            }
+            if (matchKeyword("delta"))
+            {
+                return (matchSymbol("(") || fail("'(' expected")) && parseChannel(index) &&
+                       (matchSymbol(")") || fail("')' expected")) &&
+                       emit(LogicOpcode_DELTA, 1) && emitByte(index);
+            }
+            if (matchKeyword("ondelay"))
+            {
+                return (matchSymbol("(") || fail("'(' expected")) && parseTimer(LogicOpcode_ON_DELAY);
+            }
+            if (matchKeyword("offdelay"))
+            {
+                return (matchSymbol("(") || fail("'(' expected")) && parseTimer(LogicOpcode_OFF_DELAY);
+            }
+
+            skipSpace();
+            if (strncasecmp(position, "ch", 2) == 0)
+            {
+                return parseChannel(index) && emit(LogicOpcode_CHANNEL, 1) && emitByte(index);
+            }
+
+            if (!parseNumber(value))
+            {
+                return false;
+            }
+            if (value < INT16_MIN || value > INT16_MAX)
+            {
+                return fail("number out of range");
+            }
+            return emit(LogicOpcode_CONST, 1) && emitByte(value & 0xFF) && emitByte((value >> 8) & 0xFF);
+        }
+
+        bool parseCompare()
+        {
+            if (!parseOperand())
+            {
+                return false;
+            }
+
+            // Two character operators first
+            static const struct
+            {
+                const char *symbol;
+                LogicOpcode opcode;
+            } operators[] = {
+                {"<=", LogicOpcode_LE}, {">=", LogicOpcode_GE}, {"==", LogicOpcode_EQ},
+                {"!=", LogicOpcode_NE}, {"<", LogicOpcode_LT}, {">", LogicOpcode_GT}};
+
+            for (const auto &op : operators)
+            {
+                if (matchSymbol(op.symbol))
+                {
+                    return parseOperand() && emit(op.opcode, -1);
+                }
+            }
+            return true;
+        }
+
+        bool parseNot()
+        {
+            if (matchSymbol("!") || matchKeyword("not"))
+            {
+                return parseNot() && emit(LogicOpcode_NOT, 0);
+            }
+            return parseCompare();
+        }
+
+        bool parseAnd()
+        {
+            if (!parseNot())
+            {
+                return false;
+            }
+            while (matchSymbol("&&") || matchKeyword("and"))
+            {
+                if (!parseNot() || !emit(LogicOpcode_AND, -1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool parseOr()
+        {
+            if (!parseAnd())
+            {
+                return false;
+            }
+            while (matchSymbol("||") || matchKeyword("or"))
+            {
+                if (!parseAnd() || !emit(LogicOpcode_OR, -1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
+
+bool LogicProgram::compile(const char *source, const char *&error)
+{
+    length = 0;
+    timerCount = 0;
+    memset(timers, 0, sizeof(timers));
+
+    LogicCompiler compiler(source, *this);
+    bool compiled = compiler.parseOr();
+    compiler.skipSpace();
+    if (compiled && *compiler.position != '\0')
+    {
+        compiled = compiler.fail("unexpected text at end");
+    }
+
+    error = compiler.error;
+    if (!compiled)
+    {
+        length = 0;
+    }
+    return compiled;
+}
+
+LogicEngine::LogicEngine()
+{
+    clear();
+}
+
+void LogicEngine::clear()
+{
+    channels = 0;
+    hasPreviousValues = false;
+}
+
+bool LogicEngine::setExpression(uint8_t channel, const char *source)
+{
+    if (channel < FIRST_LOGIC_CHANNEL || channel > LAST_LOGIC_CHANNEL)
+    {
+        LOG.errorf("LogicEngine", "Channel %d is not a logic channel (%d-%d)", channel, FIRST_LOGIC_CHANNEL, LAST_LOGIC_CHANNEL);
+        return false;
+    }
+
+    uint8_t slot = channel - FIRST_LOGIC_CHANNEL;
+    const char *error = nullptr;
+    if (!programs[slot].compile(source, error))
+    {
+        LOG.errorf("LogicEngine", "Channel %d: %s in '%s'", channel, error, source);
+        channels &= ~(1UL << slot);
+        return false;
+    }
+
+    channels |= 1UL << slot;
+    LOG.debugf("LogicEngine", "Channel %d: '%s' compiled to %d bytes", channel, source, programs[slot].length);
+    return true;
+}
+
+void LogicEngine::evaluate(uint16_t *channelValues, bool failsafe, unsigned long now, ChannelMask &changed)
+{
+    if (!hasPreviousValues)
+    {
+        memcpy(previousValues, channelValues, sizeof(previousValues));
+        hasPreviousValues = true;
+    }
+
+    for (uint32_t pending = channels; pending; pending &= pending - 1)
+    {
+        uint8_t slot = __builtin_ctz(pending);
+        uint16_t value = run(programs[slot], channelValues, previousValues, failsafe, now) ? CHANNEL_MAX : CHANNEL_MIN;
+
+        uint8_t channel = FIRST_LOGIC_CHANNEL - 1 + slot;
+        if (channelValues[channel] != value)
+        {
+            channelValues[channel] = value;
+            changed.set(channel);
+        }
+    }
+
+    memcpy(previousValues, channelValues, sizeof(previousValues));
+}
+
+int16_t LogicEngine::run(LogicProgram &program, const uint16_t *channelValues, const uint16_t *previousValues,
+                         bool failsafe, unsigned long now)
+{
+    // The compiler guarantees the stack bounds, so there are no checks here
+    int16_t stack[LOGIC_MAX_STACK];
+    uint8_t top = 0;
+    const uint8_t *code = program.code;
+    uint8_t pc = 0;
+
+    while (pc < program.length)
+    {
+        switch (code[pc++])
+        {
+        case LogicOpcode_CHANNEL:
+            stack[top++] = channelValues[code[pc++]];
+            break;
+        case LogicOpcode_DELTA:
+            stack[top++] = (int16_t)channelValues[code[pc]] - (int16_t)previousValues[code[pc]];
+            pc++;
+            break;
+        case LogicOpcode_CONST:
+            stack[top++] = (int16_t)(code[pc] | (code[pc + 1] << 8));
+            pc += 2;
+            break;
+        case LogicOpcode_FAILSAFE:
+            stack[top++] = failsafe;
+            break;
+        case LogicOpcode_LT:
+            top--;
+            stack[top - 1] = stack[top - 1] < stack[top];
+            break;
+        case LogicOpcode_GT:
+            top--;
+            stack[top - 1] = stack[top - 1] > stack[top];
+            break;
+        case LogicOpcode_LE:
+            top--;
+            stack[top - 1] = stack[top - 1] <= stack[top];
+            break;
+        case LogicOpcode_GE:
+            top--;
+            stack[top - 1] = stack[top - 1] >= stack[top];
+            break;
+        case LogicOpcode_EQ:
+            top--;
+            stack[top - 1] = stack[top - 1] == stack[top];
+            break;
+        case LogicOpcode_NE:
+            top--;
+            stack[top - 1] = stack[top - 1] != stack[top];
+            break;
+        case LogicOpcode_AND:
+            top--;
+            stack[top - 1] = stack[top - 1] && stack[top];
+            break;
+        case LogicOpcode_OR:
+            top--;
+            stack[top - 1] = stack[top - 1] || stack[top];
+            break;
+        case LogicOpcode_NOT:
+            stack[top - 1] = !stack[top - 1];
+            break;
+        case LogicOpcode_ON_DELAY:
+        case LogicOpcode_OFF_DELAY:
+        {
+            bool onDelay = code[pc - 1] == LogicOpcode_ON_DELAY;
+            uint32_t &since = program.timers[code[pc]];
+            uint16_t ms = code[pc + 1] | (code[pc + 2] << 8);
+            pc += 3;
+
+            if (onDelay)
+            {
+                // Start when the condition rises, true once it held for ms
+                if (!stack[top - 1])
+                {
+                    since = 0;
+                }
+                else if (since == 0)
+                {
+                    since = now ? now : 1;
+                }
+                stack[top - 1] = since != 0 && (int32_t)(now - since) >= ms;
+            }
+            else
+            {
+                // Restart while the condition holds, true until ms after it fell
+                if (stack[top - 1])
+                {
+                    since = now ? now : 1;
+                }
+                else if (since != 0 && (int32_t)(now - since) >= ms)
+                {
+                    since = 0;
+                }
+                stack[top - 1] = since != 0;
+            }
+            break;
+        }
+        }
+    }
+
+    return stack[0];
+}
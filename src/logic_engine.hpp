@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Arduino.h>
+#include "channels.hpp"
+
+// Bounds of a single compiled expression
+#define LOGIC_MAX_EXPRESSION 48 // Source length including the terminator
+#define LOGIC_MAX_CODE 48       // Bytecode bytes
+#define LOGIC_MAX_INSTRUCTIONS 24
+#define LOGIC_MAX_STACK 8
+#define LOGIC_MAX_TIMERS 4
+
+enum LogicOpcode : uint8_t
+{
+    LogicOpcode_CHANNEL,   // <index> push channel value
+    LogicOpcode_DELTA,     // <index> push change of a channel since the last tick
+    LogicOpcode_CONST,     // <lo> <hi> push 16 bit constant
+    LogicOpcode_FAILSAFE,  // push 1 while in failsafe
+    LogicOpcode_LT,
+    LogicOpcode_GT,
+    LogicOpcode_LE,
+    LogicOpcode_GE,
+    LogicOpcode_EQ,
+    LogicOpcode_NE,
+    LogicOpcode_AND,
+    LogicOpcode_OR,
+    LogicOpcode_NOT,
+    LogicOpcode_ON_DELAY,  // <timer> <lo> <hi> true once the condition held for ms
+    LogicOpcode_OFF_DELAY  // <timer> <lo> <hi> stays true for ms after the condition dropped
+};
+
+/**
+ * @brief A logic expression compiled to stack bytecode
+ */
+struct LogicProgram
+{
+    uint8_t code[LOGIC_MAX_CODE];
+    uint8_t length;
+    uint8_t timerCount;
+    uint32_t timers[LOGIC_MAX_TIMERS]; // millis() a timer started, 0 while idle
+
+    /**
+     * @brief Compile source into bytecode
+     *
+     * Grammar, keywords are case-insensitive:
+     *   or      := and (("||" | "or") and)*
+     *   and     := not (("&&" | "and") not)*
+     *   not     := ("!" | "not") not | compare
+     *   compare := operand (("<" | ">" | "<=" | ">=" | "==" | "!=") operand)?
+     *   operand := number | "ch"N | "delta(ch"N")" | "failsafe" | "true" | "false"
+     *            | "ondelay(" or "," ms ")" | "offdelay(" or "," ms ")" | "(" or ")"
+     *
+     * @param error Set to a description of the first problem on failure
+     * @return false if the source does not parse or exceeds the bounds
+     */
+    bool compile(const char *source, const char *&error);
+};
+
+/**
+ * @brief Evaluates the logic expressions into their virtual channels once per tick
+ *
+ * A logic channel is CHANNEL_MAX while its expression is true and CHANNEL_MIN otherwise.
+ */
+class LogicEngine
+{
+public:
+    LogicEngine();
+
+    void clear();
+
+    /**
+     * @brief Compile an expression for a logic channel
+     * @param channel 1-based logic channel, FIRST_LOGIC_CHANNEL..LAST_LOGIC_CHANNEL
+     */
+    bool setExpression(uint8_t channel, const char *source);
+
+    bool isEmpty() const { return channels == 0; }
+
+    /**
+     * @brief Run all expressions against the current channel values
+     * @param channelValues Values of all CHANNEL_COUNT channels, logic channels are written in place
+     * @param failsafe Whether the signal is currently lost
+     * @param now millis() for the timers
+     * @param changed Gets the bits of logic channels whose value changed
+     */
+    void evaluate(uint16_t *channelValues, bool failsafe, unsigned long now, ChannelMask &changed);
+
+private:
+    LogicProgram programs[LOGIC_CHANNEL_COUNT];
+    uint32_t channels; // Bit n set if logic channel FIRST_LOGIC_CHANNEL + n has an expression
+    uint16_t previousValues[CHANNEL_COUNT];
+    bool hasPreviousValues;
+
+    static int16_t run(LogicProgram &program, const uint16_t *channelValues, const uint16_t *previousValues,
+                       bool failsafe, unsigned long now);
+};
@@ -5,12 +5,15 @@
 #include "network_manager.hpp"
 #include "eeprom_manager.hpp"
 #include "logger.hpp"
+#include "task_model.hpp"
+#include "benchmarks/benchmarks.hpp"
 
 BoardComputer boardComputer(&Serial0);
 EEPROMManager eeprom;
 ConfigManager configManager(&boardComputer, &eeprom);
 
 NetworkManager network(&configManager, &boardComputer);
+TaskMonitor taskMonitor;
 
 void setup()
 {
@@ -21,6 +24,10 @@ void setup()
 
   LOG.info("Main", "Starting board computer");
 
+#ifdef BOARDCOMPUTER_BENCHMARKS
+  runBenchmarks();
+#endif
+
   if (!configManager.begin())
   {
     LOG.error("Main", "Failed to initialize config manager");
@@ -43,12 +50,15 @@ void setup()
 
   network.start();
   boardComputer.start();
+  taskMonitor.begin();
 
   LOG.info("Main", "Setup complete");
 }
 
 void loop()
 {
+  taskMonitor.update(millis());
+
   // Add a small delay to prevent watchdog issues
   delay(10);
 }
\ No newline at end of file
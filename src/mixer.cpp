@@ -0,0 +1,120 @@
+#include "mixer.hpp"
+#include "config_versions.hpp"
+#include "logger.hpp"
+
+Mixer::Mixer()
+{
+    clear();
+}
+
+void Mixer::clear()
+{
+    memset(rowStart, 0, sizeof(rowStart));
+    memset(offsets, 0, sizeof(offsets));
+    outputs = 0;
+    inputs.clear();
+}
+
+bool Mixer::load(const MixerConfig &config)
+{
+    clear();
+
+    for (size_t i = 0; i < MIXER_CHANNEL_COUNT; i++)
+    {
+        if ((config.outputs & (1UL << i)) && !defineOutput(FIRST_MIXER_CHANNEL + i, config.offsets[i]))
+        {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < config.numTerms; i++)
+    {
+        const MixerTermConfig &term = config.terms[i];
+        if (!addTerm(term.input, term.output, term.weight))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Mixer::defineOutput(uint8_t output, int16_t offset)
+{
+    if (output < FIRST_MIXER_CHANNEL || output > LAST_MIXER_CHANNEL)
+    {
+        LOG.errorf("Mixer", "Channel %d is not a mixer channel (%d-%d)", output, FIRST_MIXER_CHANNEL, LAST_MIXER_CHANNEL);
+        return false;
+    }
+
+    uint8_t row = output - FIRST_MIXER_CHANNEL;
+    offsets[row] = constrain(offset, CHANNEL_MIN - CHANNEL_MAX, CHANNEL_MAX - CHANNEL_MIN);
+    outputs |= 1UL << row;
+    return true;
+}
+
+bool Mixer::addTerm(uint8_t input, uint8_t output, int16_t weightPercent)
+{
+    if (input < 1 || input > HIGHEST_CHANNEL_NUMBER)
+    {
+        LOG.errorf("Mixer", "Mixer input %d is not an RC channel", input);
+        return false;
+    }
+
+    if (getTermCount() >= MIXER_MAX_TERMS)
+    {
+        LOG.errorf("Mixer", "More than %d mixer terms", MIXER_MAX_TERMS);
+        return false;
+    }
+
+    if (output < FIRST_MIXER_CHANNEL || output > LAST_MIXER_CHANNEL)
+    {
+        LOG.errorf("Mixer", "Channel %d is not a mixer channel (%d-%d)", output, FIRST_MIXER_CHANNEL, LAST_MIXER_CHANNEL);
+        return false;
+    }
+
+    if (!(outputs & (1UL << (output - FIRST_MIXER_CHANNEL))))
+    {
+        defineOutput(output, 0);
+    }
+
+    // Insert at the end of the output's row and shift the rows behind it
+    uint8_t row = output - FIRST_MIXER_CHANNEL;
+    uint16_t position = rowStart[row + 1];
+    memmove(&terms[position + 1], &terms[position], (getTermCount() - position) * sizeof(Term));
+    for (size_t i = row + 1; i <= MIXER_CHANNEL_COUNT; i++)
+    {
+        rowStart[i]++;
+    }
+
+    weightPercent = constrain(weightPercent, -MIXER_MAX_WEIGHT_PERCENT, MIXER_MAX_WEIGHT_PERCENT);
+    terms[position].input = input - 1;
+    terms[position].weight = (int32_t)weightPercent * (1 << MIXER_WEIGHT_SHIFT) / 100;
+    inputs.set(input - 1);
+    return true;
+}
+
+void Mixer::evaluate(uint16_t *channelValues, ChannelMask &changed) const
+{
+    for (uint32_t pending = outputs; pending; pending &= pending - 1)
+    {
+        uint8_t row = __builtin_ctz(pending);
+
+        int32_t sum = 0;
+        for (uint16_t t = rowStart[row]; t < rowStart[row + 1]; t++)
+        {
+            sum += terms[t].weight * ((int32_t)channelValues[terms[t].input] - CHANNEL_MID);
+        }
+
+        // Round to the nearest µs, the shift is arithmetic for negative sums
+        int32_t value = CHANNEL_MID + offsets[row] + ((sum + (1 << (MIXER_WEIGHT_SHIFT - 1))) >> MIXER_WEIGHT_SHIFT);
+        value = constrain(value, CHANNEL_MIN, CHANNEL_MAX);
+
+        uint8_t channel = HIGHEST_CHANNEL_NUMBER + row;
+        if (channelValues[channel] != value)
+        {
+            channelValues[channel] = value;
+            changed.set(channel);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include "channels.hpp"
+
+// Weights are stored as Q10 fixed point, 1024 = 100%
+#define MIXER_WEIGHT_SHIFT 10
+#define MIXER_MAX_WEIGHT_PERCENT 200
+
+struct MixerConfig;
+
+/**
+ * @brief Sparse matrix of weighted RC channels evaluated into the mixer's virtual channels
+ *
+ * Each mixer output is its center plus offset plus the sum of weight * (input - center)
+ * over its terms, clamped to the channel range. Terms are kept grouped by output so
+ * an evaluation is one pass over the terms, in integer math only.
+ */
+class Mixer
+{
+public:
+    Mixer();
+
+    /**
+     * @brief Remove all outputs and terms
+     */
+    void clear();
+
+    /**
+     * @brief Replace the matrix with the one described by config
+     * @return false if a term references an invalid channel or there are too many terms
+     */
+    bool load(const MixerConfig &config);
+
+    /**
+     * @brief Define a mixer output
+     * @param output 1-based mixer channel, FIRST_MIXER_CHANNEL..LAST_MIXER_CHANNEL
+     * @param offset µs added to the output's center
+     */
+    bool defineOutput(uint8_t output, int16_t offset);
+
+    /**
+     * @brief Add a weighted input to an output, defining the output if needed
+     * @param input 1-based RC channel
+     * @param output 1-based mixer channel
+     * @param weightPercent Share of the input's deflection from center, -MIXER_MAX_WEIGHT_PERCENT..MIXER_MAX_WEIGHT_PERCENT
+     */
+    bool addTerm(uint8_t input, uint8_t output, int16_t weightPercent);
+
+    bool isEmpty() const { return outputs == 0; }
+    size_t getTermCount() const { return rowStart[MIXER_CHANNEL_COUNT]; }
+
+    /**
+     * @brief RC channels that at least one term reads
+     */
+    const ChannelMask &getInputs() const { return inputs; }
+
+    /**
+     * @brief Recompute all outputs from the RC channels
+     * @param channelValues Values of all CHANNEL_COUNT channels, mixer outputs are written in place
+     * @param changed Gets the bits of mixer channels whose value changed
+     */
+    void evaluate(uint16_t *channelValues, ChannelMask &changed) const;
+
+private:
+    struct Term
+    {
+        uint8_t input; // 0-based RC channel
+        int16_t weight; // Q10
+    };
+
+    Term terms[MIXER_MAX_TERMS];
+    uint16_t rowStart[MIXER_CHANNEL_COUNT + 1]; // Terms of output n are rowStart[n]..rowStart[n + 1]
+    int16_t offsets[MIXER_CHANNEL_COUNT];
+    uint32_t outputs; // Bit n set if mixer channel FIRST_MIXER_CHANNEL + n is defined
+    ChannelMask inputs;
+};
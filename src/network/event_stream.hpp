@@ -59,7 +59,7 @@ public:
 
     void sendJson(EventType type, const DynamicJsonDocument &data)
     {
-        DynamicJsonDocument doc(1024);
+        DynamicJsonDocument doc(data.memoryUsage() + 256);
         doc["type"] = static_cast<int>(type);
         doc["data"] = data;
 
@@ -36,7 +36,7 @@ bool WifiManager::startAP()
 
     setupIP();
 
-    Config config = configManager->getConfig();
+    const Config &config = configManager->getConfig();
     bool apStarted = WiFi.softAP(config.apSsid, config.apPassword, 6, 0, 4);
 
     if (apStarted)
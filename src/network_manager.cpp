@@ -1,6 +1,7 @@
 #include "network_manager.hpp"
 #include "config_manager.hpp"
 #include "logger.hpp"
+#include "task_model.hpp"
 #include <SPIFFS.h>
 
 NetworkManager *NetworkManager::instance = nullptr;
@@ -38,7 +39,7 @@ void NetworkManager::start()
                 vTaskDelay(100);
             }
         },
-        "NetworkManager", 8192, this, 5, NULL);
+        TASK_NAME_NETWORK, 8192, this, TASK_PRIORITY_NETWORK, NULL);
 }
 
 void NetworkManager::update()
@@ -105,7 +106,7 @@ bool NetworkManager::shouldStart()
     }
 
     // If we get here, we're not running and don't need to run
-    if (this->configManager->getConfig().keepWebServerRunning)
+    if (this->configManager->keepWebServerRunning())
     {
         return true;
     }
@@ -219,7 +220,7 @@ void NetworkManager::startNetworkStack()
             {
                 if (nm->boardComputer)
                 {
-                    DynamicJsonDocument doc(1024);
+                    DynamicJsonDocument doc(3072);
                     doc["isReceiving"] = nm->boardComputer->isReceiving();
                     doc["hasError"] = nm->boardComputer->hasError();
 
@@ -229,12 +230,82 @@ void NetworkManager::startNetworkStack()
                         channels.add(nm->boardComputer->getChannelValue(i));
                     }
 
+                    JsonArray mixerChannels = doc.createNestedArray("mixerChannels");
+                    for (int i = HIGHEST_CHANNEL_NUMBER; i < LAST_MIXER_CHANNEL; i++)
+                    {
+                        mixerChannels.add(nm->boardComputer->getChannelValue(i));
+                    }
+
+                    JsonArray logicChannels = doc.createNestedArray("logicChannels");
+                    for (int i = LAST_MIXER_CHANNEL; i < LAST_LOGIC_CHANNEL; i++)
+                    {
+                        logicChannels.add(nm->boardComputer->getChannelValue(i));
+                    }
+
+                    JsonArray sensorChannels = doc.createNestedArray("sensorChannels");
+                    JsonArray sensorMillivolts = doc.createNestedArray("sensorMillivolts");
+                    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+                    {
+                        sensorChannels.add(nm->boardComputer->getChannelValue(FIRST_SENSOR_CHANNEL - 1 + i));
+                        sensorMillivolts.add(nm->boardComputer->getAdcSampler().getMillivolts(i));
+                    }
+
+                    InputStats inputStats = nm->boardComputer->getInputStats();
+                    JsonObject input = doc.createNestedObject("input");
+                    input["protocol"] = inputProtocolName(inputStats.protocol);
+                    input["framesDispatched"] = inputStats.framesDispatched;
+                    input["framesCoalesced"] = inputStats.framesCoalesced;
+                    input["frameToDispatchUs"] = inputStats.lastFrameToDispatchUs;
+                    input["maxFrameToDispatchUs"] = inputStats.maxFrameToDispatchUs;
+                    input["crcErrors"] = inputStats.crcErrors;
+                    input["decodeCycles"] = inputStats.decodeCycles;
+                    input["baudRate"] = inputStats.baudRate;
+                    input["frameToPulseUs"] = inputStats.meanFrameToPulseUs;
+                    input["maxFrameToPulseUs"] = inputStats.maxFrameToPulseUs;
+                    input["sensorOverruns"] = nm->boardComputer->getAdcSampler().getOverruns();
+
+                    LinkStats linkStats = nm->boardComputer->getLinkStats();
+                    JsonObject link = doc.createNestedObject("link");
+                    if (linkStats.valid)
+                    {
+                        link["rssi"] = -(int)linkStats.statistics.uplinkRssi1;
+                        link["lq"] = linkStats.statistics.uplinkLinkQuality;
+                        link["snr"] = linkStats.statistics.uplinkSnr;
+                        link["rfMode"] = linkStats.statistics.rfMode;
+                    }
+                    link["frameGapUs"] = linkStats.lastFrameGapUs;
+                    link["maxFrameGapUs"] = linkStats.maxFrameGapUs;
+                    link["telemetrySent"] = linkStats.telemetry.framesSent;
+                    link["telemetryDropped"] = linkStats.telemetry.framesDropped;
+
+                    FailsafeStats failsafeStats = nm->boardComputer->getFailsafeStats();
+                    JsonObject failsafe = doc.createNestedObject("failsafe");
+                    failsafe["stage"] = failsafeStats.stage;
+                    failsafe["lastFrameAt"] = failsafeStats.lastFrameAt;
+                    failsafe["enteredAt"] = failsafeStats.enteredAt;
+                    failsafe["rampAt"] = failsafeStats.rampAt;
+                    failsafe["settledAt"] = failsafeStats.settledAt;
+                    failsafe["recoveredAt"] = failsafeStats.recoveredAt;
+
+                    DispatchStats dispatchStats = nm->boardComputer->getDispatchStats();
+                    JsonObject dispatch = doc.createNestedObject("dispatch");
+                    dispatch["callsPerSecond"] = dispatchStats.callsPerSecond;
+                    dispatch["callsSavedPerSecond"] = dispatchStats.callsSavedPerSecond;
+                    dispatch["totalCalls"] = dispatchStats.totalCalls;
+                    dispatch["totalSaved"] = dispatchStats.totalSaved;
+                    dispatch["writesPerSecond"] = dispatchStats.writesPerSecond;
+                    dispatch["writesSkippedPerSecond"] = dispatchStats.writesSkippedPerSecond;
+                    dispatch["totalWrites"] = dispatchStats.totalWrites;
+                    dispatch["totalWritesSkipped"] = dispatchStats.totalWritesSkipped;
+                    dispatch["maxTickUs"] = dispatchStats.maxTickUs;
+                    dispatch["tickOverruns"] = dispatchStats.tickOverruns;
+
                     nm->eventStream.sendJson(EventType::TELEMETRY, doc);
                 }
                 vTaskDelay(pdMS_TO_TICKS(100)); // Update every 100ms
             }
         },
-        "TelemetryTask", 4096, this, 1, NULL);
+        TASK_NAME_TELEMETRY, 4096, this, TASK_PRIORITY_TELEMETRY, NULL);
 
     // Add delay before starting web server
     vTaskDelay(pdMS_TO_TICKS(1000));
@@ -243,6 +314,14 @@ void NetworkManager::startNetworkStack()
     server->begin();
     LOG.info("NetworkManager", "Web server started");
 
+    // Requests, including config uploads, are handled in AsyncTCP's task, which
+    // starts above the network tier
+    TaskHandle_t webTask = xTaskGetHandle(TASK_NAME_WEB);
+    if (webTask != NULL)
+    {
+        vTaskPrioritySet(webTask, TASK_PRIORITY_NETWORK);
+    }
+
     networkStackStarted = true;
     LOG.info("NetworkManager", "Network stack initialization complete");
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Conditioned values are tracked in Q8 fixed point µs
+#define CONDITIONER_SHIFT 8
+// Longest tick or frame interval the conditioner accounts for
+#define CONDITIONER_MAX_INTERVAL_US 50000
+// Longest low-pass time constant, the web page allows the same
+#define CONDITIONER_MAX_FILTER_MS 5000
+
+/**
+ * @brief How an output is smoothed between the values it receives, all off by default
+ */
+struct ConditioningProfile
+{
+    uint16_t slewRate; // Maximum speed in µs per second, 0 for no limit
+    uint16_t filterMs; // Time constant of a one-pole low-pass filter, 0 to disable
+    bool interpolate;  // Spread each new value over the interval between frames
+
+    ConditioningProfile() : slewRate(0), filterMs(0), interpolate(false) {}
+
+    bool enabled() const { return slewRate != 0 || filterMs != 0 || interpolate; }
+};
+
+/**
+ * @brief Per-output state of the conditioning stage
+ *
+ * Runs once per control tick, in O(1) per output: linear interpolation towards the
+ * latest value, then the slew limiter, then the low-pass filter.
+ */
+struct OutputConditioner
+{
+    int32_t from;       // Interpolation start, Q8
+    int32_t slewed;     // Output of the slew limiter, Q8
+    int32_t filtered;   // Output of the low-pass filter, Q8
+    uint32_t startUs;   // micros() when the current target arrived
+    uint16_t target;    // Latest value received, 0 if none yet
+    bool settling;      // Output has not reached target yet, keep ticking
+
+    OutputConditioner() { reset(0); }
+
+    /**
+     * @brief Jump straight to value, used when conditioning is bypassed
+     */
+    void reset(uint16_t value)
+    {
+        from = slewed = filtered = (int32_t)value << CONDITIONER_SHIFT;
+        target = value;
+        startUs = 0;
+        settling = false;
+    }
+
+    /**
+     * @brief Advance by one tick
+     * @param value Latest value the output should move to
+     * @param nowUs micros() of this tick
+     * @param tickUs Time since the previous tick
+     * @param frameIntervalUs Current interval between input frames, the interpolation span
+     * @return Conditioned value in µs
+     */
+    uint16_t update(const ConditioningProfile &profile, uint16_t value, uint32_t nowUs, uint32_t tickUs, uint32_t frameIntervalUs)
+    {
+        // Nothing to smooth from yet
+        if (target == 0)
+        {
+            reset(value);
+            return value;
+        }
+
+        const int32_t targetQ = (int32_t)value << CONDITIONER_SHIFT;
+        if (value != target)
+        {
+            from = profile.interpolate ? filtered : targetQ;
+            target = value;
+            startUs = nowUs;
+        }
+
+        tickUs = min(tickUs, (uint32_t)CONDITIONER_MAX_INTERVAL_US);
+
+        int32_t position = targetQ;
+        uint32_t elapsedUs = nowUs - startUs;
+        if (profile.interpolate && elapsedUs < frameIntervalUs)
+        {
+            position = from + (int32_t)((int64_t)(targetQ - from) * elapsedUs / frameIntervalUs);
+        }
+
+        if (profile.slewRate != 0)
+        {
+            // µs/s * µs / 1e6 in Q8, tickUs is bounded so this fits 32 bits
+            int32_t maxStep = max((uint32_t)1, (uint32_t)profile.slewRate * tickUs / (1000000 >> CONDITIONER_SHIFT));
+            slewed += constrain(position - slewed, -maxStep, maxStep);
+        }
+        else
+        {
+            slewed = position;
+        }
+
+        if (profile.filterMs != 0)
+        {
+            // alpha = dt / (tau + dt) in Q16
+            uint32_t alpha = (tickUs << 16) / ((uint32_t)profile.filterMs * 1000 + tickUs);
+            int32_t difference = slewed - filtered;
+            int32_t step = (int32_t)(((int64_t)abs(difference) * alpha + (1 << 15)) >> 16);
+            // Rounding alone stalls just short of the target with long time constants, always move
+            step = max(step, (int32_t)(difference != 0));
+            filtered += difference < 0 ? -step : step;
+            if (abs(slewed - filtered) < (1 << (CONDITIONER_SHIFT - 1)))
+            {
+                filtered = slewed;
+            }
+        }
+        else
+        {
+            filtered = slewed;
+        }
+
+        settling = filtered != targetQ;
+        return (filtered + (1 << (CONDITIONER_SHIFT - 1))) >> CONDITIONER_SHIFT;
+    }
+};
@@ -0,0 +1,190 @@
+#include "ledc_driver.hpp"
+#include "logger.hpp"
+#include <driver/gpio.h>
+#include <soc/ledc_struct.h>
+
+LedcDriver::LedcDriver() : fadeInstalled(false)
+{
+    memset(timers, 0, sizeof(timers));
+    memset(channels, 0, sizeof(channels));
+}
+
+int8_t LedcDriver::claimTimer(uint32_t frequencyHz, uint8_t resolutionBits)
+{
+    int8_t unused = -1;
+    for (int8_t i = 0; i < LEDC_TIMER_COUNT; i++)
+    {
+        Timer &timer = timers[i];
+        if (timer.users > 0 && timer.frequencyHz == frequencyHz && timer.resolutionBits == resolutionBits)
+        {
+            timer.users++;
+            return i;
+        }
+        if (timer.users == 0 && unused < 0)
+        {
+            unused = i;
+        }
+    }
+
+    if (unused < 0)
+    {
+        LOG.errorf("LedcDriver", "All %d timers are in use, no room for %luHz", LEDC_TIMER_COUNT, frequencyHz);
+        return -1;
+    }
+
+    ledc_timer_config_t timerConfig = {};
+    timerConfig.speed_mode = LEDC_LOW_SPEED_MODE;
+    timerConfig.duty_resolution = (ledc_timer_bit_t)resolutionBits;
+    timerConfig.timer_num = (ledc_timer_t)unused;
+    timerConfig.freq_hz = frequencyHz;
+    timerConfig.clk_cfg = LEDC_AUTO_CLK;
+    esp_err_t result = ledc_timer_config(&timerConfig);
+    if (result != ESP_OK)
+    {
+        LOG.errorf("LedcDriver", "Timer %d cannot run at %luHz with %d bits: %s",
+                   unused, frequencyHz, resolutionBits, esp_err_to_name(result));
+        return -1;
+    }
+
+    timers[unused].frequencyHz = frequencyHz;
+    timers[unused].resolutionBits = resolutionBits;
+    timers[unused].users = 1;
+    LOG.debugf("LedcDriver", "Timer %d runs at %luHz with %d bits", unused, frequencyHz, resolutionBits);
+    return unused;
+}
+
+void LedcDriver::releaseTimer(uint8_t timer)
+{
+    if (timers[timer].users > 0 && --timers[timer].users == 0)
+    {
+        ledc_timer_pause(LEDC_LOW_SPEED_MODE, (ledc_timer_t)timer);
+        ledc_timer_rst(LEDC_LOW_SPEED_MODE, (ledc_timer_t)timer);
+    }
+}
+
+int8_t LedcDriver::attach(uint8_t pin, uint32_t frequencyHz, uint8_t resolutionBits)
+{
+    if (frequencyHz == 0 || resolutionBits < 1 || resolutionBits > LEDC_MAX_RESOLUTION_BITS ||
+        ((uint64_t)frequencyHz << resolutionBits) > LEDC_SOURCE_CLOCK_HZ)
+    {
+        LOG.errorf("LedcDriver", "%luHz with %d bits is not possible on pin %d", frequencyHz, resolutionBits, pin);
+        return -1;
+    }
+
+    int8_t channel = -1;
+    for (int8_t i = 0; i < LEDC_CHANNEL_COUNT; i++)
+    {
+        if (!channels[i].used)
+        {
+            channel = i;
+            break;
+        }
+    }
+    if (channel < 0)
+    {
+        LOG.errorf("LedcDriver", "All %d channels are in use, no room for pin %d", LEDC_CHANNEL_COUNT, pin);
+        return -1;
+    }
+
+    int8_t timer = claimTimer(frequencyHz, resolutionBits);
+    if (timer < 0)
+    {
+        return -1;
+    }
+
+    ledc_channel_config_t channelConfig = {};
+    channelConfig.gpio_num = pin;
+    channelConfig.speed_mode = LEDC_LOW_SPEED_MODE;
+    channelConfig.channel = (ledc_channel_t)channel;
+    channelConfig.intr_type = LEDC_INTR_DISABLE;
+    channelConfig.timer_sel = (ledc_timer_t)timer;
+    channelConfig.duty = 0;
+    channelConfig.hpoint = 0;
+    esp_err_t result = ledc_channel_config(&channelConfig);
+    if (result != ESP_OK)
+    {
+        LOG.errorf("LedcDriver", "Channel %d cannot drive pin %d: %s", channel, pin, esp_err_to_name(result));
+        releaseTimer(timer);
+        return -1;
+    }
+
+    Channel &state = channels[channel];
+    state.used = true;
+    state.pin = pin;
+    state.timer = timer;
+    state.duty = 0;
+    state.countsPerUsQ16 = ((uint64_t)frequencyHz << (resolutionBits + 16)) / 1000000;
+    LOG.debugf("LedcDriver", "Pin %d on channel %d, timer %d", pin, channel, timer);
+    return channel;
+}
+
+void LedcDriver::detach(int8_t channel)
+{
+    if (channel < 0 || channel >= LEDC_CHANNEL_COUNT || !channels[channel].used)
+    {
+        return;
+    }
+
+    Channel &state = channels[channel];
+    ledc_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, 0);
+    releaseTimer(state.timer);
+    state.used = false;
+
+    // Take the pin back from the LEDC so the next output can use it as a plain GPIO
+    gpio_reset_pin((gpio_num_t)state.pin);
+    pinMode(state.pin, OUTPUT);
+    digitalWrite(state.pin, LOW);
+}
+
+void LedcDriver::fade(int8_t channel, uint32_t duty, uint32_t timeMs)
+{
+    if (!fadeInstalled)
+    {
+        // Fades end in the LEDC interrupt, the service for it is only set up once something fades
+        ledc_fade_func_install(0);
+        fadeInstalled = true;
+    }
+
+    // The cached duty is where the fade ends, stopFade() corrects it if it ends early
+    channels[channel].duty = duty;
+    ledc_set_fade_time_and_start(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, duty, timeMs, LEDC_FADE_NO_WAIT);
+}
+
+void LedcDriver::stopFade(int8_t channel)
+{
+    if (!fadeInstalled)
+    {
+        return;
+    }
+
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel);
+    channels[channel].duty = ledc_get_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel);
+}
+
+uint32_t LedcDriver::getMicrosToPeriodEnd(int8_t channel) const
+{
+    const Timer &timer = timers[channels[channel].timer];
+    uint32_t count = LEDC.timer_group[LEDC_LOW_SPEED_MODE].timer[channels[channel].timer].value.timer_cnt;
+    uint32_t remaining = (1UL << timer.resolutionBits) - count;
+    return (uint64_t)remaining * 1000000 / ((uint64_t)timer.frequencyHz << timer.resolutionBits);
+}
+
+uint8_t LedcDriver::getUsedChannels() const
+{
+    uint8_t count = 0;
+    for (int8_t i = 0; i < LEDC_CHANNEL_COUNT; i++)
+    {
+        count += channels[i].used;
+    }
+    return count;
+}
+
+uint8_t LedcDriver::getUsedTimers() const
+{
+    uint8_t count = 0;
+    for (int8_t i = 0; i < LEDC_TIMER_COUNT; i++)
+    {
+        count += timers[i].users > 0;
+    }
+    return count;
+}
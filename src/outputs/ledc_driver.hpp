@@ -0,0 +1,120 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/ledc.h>
+
+// The ESP32-C3 only has the low speed LEDC group: 4 timers shared by 6 channels
+#define LEDC_TIMER_COUNT LEDC_TIMER_MAX
+#define LEDC_CHANNEL_COUNT LEDC_CHANNEL_MAX
+// Clock the timers divide down, frequency * 2^resolution must not exceed it
+#define LEDC_SOURCE_CLOCK_HZ 80000000
+#define LEDC_MAX_RESOLUTION_BITS 14
+
+/**
+ * @brief Hands out LEDC channels and shares timers between outputs of the same frequency
+ *
+ * Channels are attached and detached from the control task, each channel is then only
+ * written by the task that owns the output.
+ */
+class LedcDriver
+{
+public:
+    LedcDriver();
+
+    /**
+     * @brief Route a channel to pin, reusing a timer already running at this frequency and resolution
+     * @return The channel, -1 if no channel or timer is free or the timer cannot run at this frequency and resolution
+     */
+    int8_t attach(uint8_t pin, uint32_t frequencyHz, uint8_t resolutionBits);
+
+    /**
+     * @brief Stop the channel, leave its pin a low GPIO and stop the timer once nobody uses it
+     */
+    void detach(int8_t channel);
+
+    /**
+     * @brief Set the duty in timer counts, 0..getFullDuty()
+     * The registers are only touched if the duty changed.
+     */
+    inline void write(int8_t channel, uint32_t duty)
+    {
+        Channel &state = channels[channel];
+        if (duty == state.duty)
+        {
+            return;
+        }
+        state.duty = duty;
+        ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, duty);
+        ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel);
+    }
+
+    /**
+     * @brief Let the hardware ramp the duty to duty over timeMs, nothing has to run while it fades
+     * Call stopFade() before writing a channel that may still be fading.
+     */
+    void fade(int8_t channel, uint32_t duty, uint32_t timeMs);
+
+    /**
+     * @brief Stop a running fade where it is
+     */
+    void stopFade(int8_t channel);
+
+    /**
+     * @brief Set the pulse width, limited to the period
+     */
+    inline void writeMicroseconds(int8_t channel, uint32_t us)
+    {
+        write(channel, microsecondsToDuty(channel, us));
+    }
+
+    /**
+     * @brief Duty for a pulse width, limited to the period
+     */
+    inline uint32_t microsecondsToDuty(int8_t channel, uint32_t us) const
+    {
+        const Channel &state = channels[channel];
+        return min((uint32_t)(((uint64_t)us * state.countsPerUsQ16) >> 16), getFullDuty(channel));
+    }
+
+    /**
+     * @brief Time until the channel's timer starts its next period, which is when a new duty takes effect
+     */
+    uint32_t getMicrosToPeriodEnd(int8_t channel) const;
+
+    /**
+     * @brief Duty last written to the channel
+     */
+    uint32_t getDuty(int8_t channel) const { return channels[channel].duty; }
+
+    /**
+     * @brief Duty of an always high output
+     */
+    uint32_t getFullDuty(int8_t channel) const { return 1UL << timers[channels[channel].timer].resolutionBits; }
+
+    uint8_t getUsedChannels() const;
+    uint8_t getUsedTimers() const;
+
+private:
+    struct Timer
+    {
+        uint32_t frequencyHz;
+        uint8_t resolutionBits;
+        uint8_t users; // Channels running off this timer, 0 if free
+    };
+
+    struct Channel
+    {
+        bool used;
+        uint8_t pin;
+        uint8_t timer;
+        uint32_t duty;
+        uint32_t countsPerUsQ16; // Timer counts per µs, Q16 fixed point
+    };
+
+    Timer timers[LEDC_TIMER_COUNT];
+    Channel channels[LEDC_CHANNEL_COUNT];
+    bool fadeInstalled;
+
+    int8_t claimTimer(uint32_t frequencyHz, uint8_t resolutionBits);
+    void releaseTimer(uint8_t timer);
+};
@@ -0,0 +1,95 @@
+#include "output_shadow.hpp"
+#include "logger.hpp"
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+OutputShadow::OutputShadow(LedcDriver &ledc) : ledc(ledc), desired(0), dirty(0), output(0), known(0), dirtyDuties(0)
+{
+    memset(duties, 0, sizeof(duties));
+}
+
+void OutputShadow::claim(uint8_t pin)
+{
+    if (pin > OUTPUT_SHADOW_MAX_PIN)
+    {
+        LOG.errorf("OutputShadow", "Pin %d is not in the GPIO output register", pin);
+        return;
+    }
+
+    // The pin may have been driven by something else since the shadow last wrote it
+    pinMode(pin, OUTPUT);
+    known &= ~(1UL << pin);
+}
+
+void OutputShadow::release(uint8_t pin)
+{
+    if (pin > OUTPUT_SHADOW_MAX_PIN)
+    {
+        return;
+    }
+
+    uint32_t bit = 1UL << pin;
+    REG_WRITE(GPIO_OUT_W1TC_REG, bit);
+    dirty &= ~bit;
+    known &= ~bit;
+    output &= ~bit;
+}
+
+void OutputShadow::commitDigital(uint32_t &writes, uint32_t &skipped)
+{
+    if (dirty != 0)
+    {
+        uint32_t changed = dirty & (~known | (desired ^ output));
+        uint32_t set = changed & desired;
+        uint32_t clear = changed & ~desired;
+
+        if (set != 0)
+        {
+            REG_WRITE(GPIO_OUT_W1TS_REG, set);
+        }
+        if (clear != 0)
+        {
+            REG_WRITE(GPIO_OUT_W1TC_REG, clear);
+        }
+
+        output = (output & ~changed) | set;
+        known |= changed;
+        writes += __builtin_popcount(changed);
+        skipped += __builtin_popcount(dirty & ~changed);
+        dirty = 0;
+    }
+}
+
+void OutputShadow::commitDuties(uint32_t &writes, uint32_t &skipped)
+{
+    for (int8_t channel = 0; dirtyDuties != 0; channel++, dirtyDuties >>= 1)
+    {
+        if ((dirtyDuties & 1) == 0)
+        {
+            continue;
+        }
+
+        if (ledc.getDuty(channel) == duties[channel])
+        {
+            skipped++;
+        }
+        else
+        {
+            ledc.write(channel, duties[channel]);
+            writes++;
+        }
+    }
+}
+
+uint32_t OutputShadow::getMicrosToNextPeriod() const
+{
+    uint32_t next = UINT32_MAX;
+    for (int8_t channel = 0; channel < LEDC_CHANNEL_COUNT; channel++)
+    {
+        if (dirtyDuties & (1 << channel))
+        {
+            next = min(next, ledc.getMicrosToPeriodEnd(channel));
+        }
+    }
+    return next;
+}
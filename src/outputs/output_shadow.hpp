@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ledc_driver.hpp"
+
+// All ESP32-C3 GPIOs live in the first output register
+#define OUTPUT_SHADOW_MAX_PIN 31
+
+/**
+ * @brief Output state the handlers write during a tick, put on the pins at the end of it
+ *
+ * Digital outputs that change in a tick all switch with one W1TS and one W1TC register
+ * write, PWM duties are only handed to the LEDC if they differ from what it outputs.
+ * Only the control task uses the shadow.
+ */
+class OutputShadow
+{
+public:
+    OutputShadow(LedcDriver &ledc);
+
+    /**
+     * @brief Make pin an output, its level is unknown until the next commit writes it
+     */
+    void claim(uint8_t pin);
+
+    /**
+     * @brief Drive pin low right away and forget it, before its handler is detached
+     * A level left pending would otherwise be committed over the pin's next owner.
+     */
+    void release(uint8_t pin);
+
+    void setDigital(uint8_t pin, bool high)
+    {
+        uint32_t bit = 1UL << pin;
+        dirty |= bit;
+        desired = high ? desired | bit : desired & ~bit;
+    }
+
+    /**
+     * @brief Duty of an attached LEDC channel, in timer counts
+     */
+    void setDuty(int8_t channel, uint32_t duty)
+    {
+        duties[channel] = duty;
+        dirtyDuties |= 1 << channel;
+    }
+
+    /**
+     * @brief Put everything set since the last commit on the pins
+     * @param writes Incremented by the outputs that changed
+     * @param skipped Incremented by the outputs that were set to what they already output
+     */
+    void commit(uint32_t &writes, uint32_t &skipped)
+    {
+        commitDigital(writes, skipped);
+        commitDuties(writes, skipped);
+    }
+
+    /**
+     * @brief Switch the digital outputs set since the last commit
+     */
+    void commitDigital(uint32_t &writes, uint32_t &skipped);
+
+    /**
+     * @brief Hand the duties set since the last commit to the LEDC, they take effect when each timer's period ends
+     */
+    void commitDuties(uint32_t &writes, uint32_t &skipped);
+
+    /**
+     * @brief Forget a duty that was not committed yet, before the channel is detached
+     */
+    void dropDuty(int8_t channel) { dirtyDuties &= ~(1 << channel); }
+
+    bool hasPendingDuties() const { return dirtyDuties != 0; }
+
+    /**
+     * @brief Time until the first period ends that a pending duty would show up in
+     */
+    uint32_t getMicrosToNextPeriod() const;
+
+private:
+    LedcDriver &ledc;
+    uint32_t desired; // Level of each pin as set in this tick
+    uint32_t dirty;   // Pins set since the last commit
+    uint32_t output;  // Level last written to each pin
+    uint32_t known;   // Pins whose output level was written by a commit since they were claimed
+    uint32_t duties[LEDC_CHANNEL_COUNT];
+    uint8_t dirtyDuties;
+};
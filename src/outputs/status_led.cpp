@@ -0,0 +1,107 @@
+#include "status_led.hpp"
+#include "pattern_scheduler.hpp"
+#include "logger.hpp"
+
+struct StatusLedSteps
+{
+    const PatternStep *steps;
+    uint8_t length;
+};
+
+static const PatternStep OFF_STEPS[] = {{0, false, 0}};
+static const PatternStep SLOW_BLINK_STEPS[] = {{255, false, 500}, {0, false, 500}};
+static const PatternStep BREATHE_STEPS[] = {{255, true, 2550}, {0, true, 2550}};
+static const PatternStep FAST_BLINK_STEPS[] = {{255, false, 150}, {0, false, 150}};
+static const PatternStep DOUBLE_BLINK_STEPS[] = {{255, false, 100}, {0, false, 100}, {255, false, 100}, {0, false, 500}};
+
+static const StatusLedSteps PATTERNS[StatusLedPattern_COUNT] = {
+    {OFF_STEPS, 1},
+    {SLOW_BLINK_STEPS, 2},
+    {BREATHE_STEPS, 2},
+    {FAST_BLINK_STEPS, 2},
+    {DOUBLE_BLINK_STEPS, 4},
+};
+
+StatusLed::StatusLed(LedcDriver &ledc)
+    : ledc(ledc), pin(0), channel(-1), timer(NULL), requestedPattern(StatusLedPattern_OFF),
+      pattern(StatusLedPattern_COUNT), step(0)
+{
+}
+
+void StatusLed::begin(uint8_t pin)
+{
+    this->pin = pin;
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    // Same timer as dimmed pattern outputs, so the LED does not cost one of the four
+    channel = ledc.attach(pin, PATTERN_PWM_FREQUENCY, PATTERN_PWM_RESOLUTION);
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = [](void *arg)
+    { static_cast<StatusLed *>(arg)->advance(); };
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "statusLed";
+    esp_err_t result = esp_timer_create(&timerArgs, &timer);
+    if (result != ESP_OK)
+    {
+        LOG.errorf("StatusLed", "No timer for the status LED: %s", esp_err_to_name(result));
+        timer = NULL;
+        return;
+    }
+
+    esp_timer_start_once(timer, 0);
+    LOG.debug("StatusLed", "Status LED initialized");
+}
+
+void StatusLed::show(StatusLedPattern pattern)
+{
+    if (requestedPattern.exchange(pattern) == pattern || timer == NULL)
+    {
+        return;
+    }
+
+    // Cut the current step short. A callback running right now rearms nothing after this,
+    // if it already picked up the new pattern the extra call only moves on one step.
+    esp_timer_stop(timer);
+    esp_timer_start_once(timer, 0);
+}
+
+void StatusLed::advance()
+{
+    uint8_t requested = requestedPattern.load();
+    if (requested != pattern)
+    {
+        pattern = requested;
+        step = 0;
+    }
+    else
+    {
+        step = (step + 1) % PATTERNS[pattern].length;
+    }
+
+    const PatternStep &current = PATTERNS[pattern].steps[step];
+    if (channel < 0)
+    {
+        // Switched LEDs jump to where a fade goes
+        digitalWrite(pin, current.level >= 128 ? HIGH : LOW);
+    }
+    else
+    {
+        ledc.stopFade(channel);
+        if (current.fade)
+        {
+            ledc.fade(channel, current.level, current.durationMs);
+        }
+        else
+        {
+            ledc.write(channel, current.level);
+        }
+    }
+
+    if (current.durationMs > 0)
+    {
+        // Fails harmlessly if show() already fired the timer for the next pattern
+        esp_timer_start_once(timer, (uint64_t)current.durationMs * 1000);
+    }
+}
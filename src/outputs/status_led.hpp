@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_timer.h>
+#include "channel-handlers/patternProgram.hpp"
+#include "outputs/ledc_driver.hpp"
+
+enum StatusLedPattern
+{
+    StatusLedPattern_OFF,
+    StatusLedPattern_SLOW_BLINK,   // 1Hz
+    StatusLedPattern_BREATHE,      // Fades up and down over about five seconds
+    StatusLedPattern_FAST_BLINK,   // 3.3Hz
+    StatusLedPattern_DOUBLE_BLINK, // Two short blinks, then a pause
+    StatusLedPattern_COUNT
+};
+
+/**
+ * @brief Shows a pattern on the status LED without a task of its own
+ *
+ * Patterns are a few steps, a step either jumps to its level or has the LEDC fade to
+ * it in hardware. A one-shot esp_timer fires when a step ends and programs the next
+ * one, so breathing costs two timer callbacks per cycle. All LEDC writes happen in the
+ * timer callback, show() only fires the timer right away, so a new pattern is visible
+ * immediately instead of when the current step would have ended.
+ */
+class StatusLed
+{
+public:
+    StatusLed(LedcDriver &ledc);
+
+    /**
+     * @brief Take over the pin and start showing the last requested pattern
+     */
+    void begin(uint8_t pin);
+
+    /**
+     * @brief Switch to a pattern, starting with its first step, callable from any task
+     */
+    void show(StatusLedPattern pattern);
+
+private:
+    LedcDriver &ledc;
+    uint8_t pin;
+    int8_t channel; // LEDC channel, -1 if the LED is only switched
+    esp_timer_handle_t timer;
+    std::atomic<uint8_t> requestedPattern;
+
+    // Only touched by the timer callback
+    uint8_t pattern;
+    uint8_t step;
+
+    void advance();
+};
@@ -0,0 +1,138 @@
+#include "ws2812_driver.hpp"
+#include "logger.hpp"
+
+// WS2812 bit timings in ns
+#define WS2812_T0H_NS 400
+#define WS2812_T0L_NS 850
+#define WS2812_T1H_NS 800
+#define WS2812_T1L_NS 450
+
+// RMT items for a 0 and a 1 bit, the same for all strips since they share the clock divider
+static rmt_item32_t bitItems[2];
+
+/**
+ * @brief RMT translator, turns pixel bytes into one item per bit as the RMT memory drains
+ */
+static void IRAM_ATTR encodePixels(const void *source, rmt_item32_t *items, size_t sourceSize, size_t wantedItems,
+                                   size_t *translatedSize, size_t *itemCount)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(source);
+    size_t size = 0;
+    size_t count = 0;
+    while (size < sourceSize && count + 8 <= wantedItems)
+    {
+        uint8_t byte = bytes[size++];
+        for (uint8_t bit = 0; bit < 8; bit++, byte <<= 1)
+        {
+            items[count++] = bitItems[byte >> 7];
+        }
+    }
+    *translatedSize = size;
+    *itemCount = count;
+}
+
+Ws2812Driver::Ws2812Driver()
+{
+    memset(strips, 0, sizeof(strips));
+}
+
+int8_t Ws2812Driver::attach(uint8_t pin, uint16_t numPixels)
+{
+    if (numPixels == 0 || numPixels > WS2812_MAX_PIXELS)
+    {
+        LOG.errorf("Ws2812Driver", "%d pixels on pin %d, 1-%d are supported", numPixels, pin, WS2812_MAX_PIXELS);
+        return -1;
+    }
+
+    int8_t strip = -1;
+    for (int8_t i = 0; i < WS2812_MAX_STRIPS; i++)
+    {
+        if (!strips[i].used)
+        {
+            strip = i;
+            break;
+        }
+    }
+    if (strip < 0)
+    {
+        LOG.errorf("Ws2812Driver", "All %d RMT channels are in use, no room for pin %d", WS2812_MAX_STRIPS, pin);
+        return -1;
+    }
+
+    rmt_channel_t channel = (rmt_channel_t)strip;
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, channel);
+    config.clk_div = 2; // 40MHz, 25ns resolution
+    esp_err_t result = rmt_config(&config);
+    if (result == ESP_OK)
+    {
+        result = rmt_driver_install(channel, 0, 0);
+    }
+    if (result == ESP_OK)
+    {
+        result = rmt_translator_init(channel, encodePixels);
+    }
+    if (result != ESP_OK)
+    {
+        LOG.errorf("Ws2812Driver", "RMT channel %d cannot drive pin %d: %s", strip, pin, esp_err_to_name(result));
+        rmt_driver_uninstall(channel);
+        return -1;
+    }
+
+    uint32_t clockHz = 0;
+    rmt_get_counter_clock(channel, &clockHz);
+    uint32_t ticksPerUs = clockHz / 1000000;
+    bitItems[0] = {{{(uint16_t)(WS2812_T0H_NS * ticksPerUs / 1000), 1, (uint16_t)(WS2812_T0L_NS * ticksPerUs / 1000), 0}}};
+    bitItems[1] = {{{(uint16_t)(WS2812_T1H_NS * ticksPerUs / 1000), 1, (uint16_t)(WS2812_T1L_NS * ticksPerUs / 1000), 0}}};
+
+    Strip &state = strips[strip];
+    memset(&state, 0, sizeof(state));
+    state.used = true;
+    state.lastShowUs = micros() - (numPixels * WS2812_PIXEL_US + WS2812_LATCH_US); // Ready for the first frame
+    state.pin = pin;
+    state.numPixels = numPixels;
+    LOG.debugf("Ws2812Driver", "%d pixels on pin %d, RMT channel %d", numPixels, pin, strip);
+    return strip;
+}
+
+void Ws2812Driver::detach(int8_t strip)
+{
+    if (strip < 0 || strip >= WS2812_MAX_STRIPS || !strips[strip].used)
+    {
+        return;
+    }
+
+    // The front buffer must not be reused while the RMT interrupt still reads it
+    rmt_wait_tx_done((rmt_channel_t)strip, pdMS_TO_TICKS(10));
+    rmt_driver_uninstall((rmt_channel_t)strip);
+    strips[strip].used = false;
+
+    pinMode(strips[strip].pin, OUTPUT);
+    digitalWrite(strips[strip].pin, LOW);
+}
+
+bool Ws2812Driver::show(int8_t strip)
+{
+    Strip &state = strips[strip];
+    uint32_t frameUs = state.numPixels * WS2812_PIXEL_US + WS2812_LATCH_US;
+    if (micros() - state.lastShowUs < frameUs || rmt_wait_tx_done((rmt_channel_t)strip, 0) != ESP_OK)
+    {
+        state.framesBusy++;
+        return false;
+    }
+
+    uint8_t front = state.back;
+    state.back ^= 1;
+    rmt_write_sample((rmt_channel_t)strip, state.buffers[front], state.numPixels * 3, false);
+    state.lastShowUs = micros();
+    state.framesShown++;
+    return true;
+}
+
+void Ws2812Driver::clear(int8_t strip)
+{
+    memset(strips[strip].buffers[strips[strip].back], 0, strips[strip].numPixels * 3);
+    while (!show(strip))
+    {
+        delayMicroseconds(WS2812_LATCH_US);
+    }
+}
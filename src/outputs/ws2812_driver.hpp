@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/rmt.h>
+
+// The ESP32-C3 has two RMT transmit channels
+#define WS2812_MAX_STRIPS 2
+#define WS2812_MAX_PIXELS 120
+// Time on the wire per pixel, and the low time after which WS2812 latch a frame
+#define WS2812_PIXEL_US 30
+#define WS2812_LATCH_US 300
+// Outputs send at most 100 frames per second
+#define WS2812_FRAME_INTERVAL_US 10000
+
+/**
+ * @brief Drives WS2812 strips from the RMT peripheral without blocking
+ *
+ * Every strip has two pixel buffers. Outputs render into the back buffer, show()
+ * swaps it to the front and starts the transmission, the RMT driver then encodes
+ * the front buffer into RMT items from its interrupt while the bits go out. The new
+ * back buffer holds an older frame, so outputs render every pixel of every frame.
+ * Only the control task uses the driver.
+ */
+class Ws2812Driver
+{
+public:
+    Ws2812Driver();
+
+    /**
+     * @brief Set up an RMT channel for a strip on pin
+     * @return Id of the strip, -1 if no channel is free or numPixels exceeds WS2812_MAX_PIXELS
+     */
+    int8_t attach(uint8_t pin, uint16_t numPixels);
+
+    /**
+     * @brief Wait for the last frame, release the RMT channel and leave the pin low
+     */
+    void detach(int8_t strip);
+
+    inline void setPixel(int8_t strip, uint16_t index, uint8_t red, uint8_t green, uint8_t blue)
+    {
+        // WS2812 take their colours green first
+        uint8_t *pixel = &strips[strip].buffers[strips[strip].back][index * 3];
+        pixel[0] = green;
+        pixel[1] = red;
+        pixel[2] = blue;
+    }
+
+    /**
+     * @brief Send the back buffer, unless the previous frame is still on the wire or latching
+     * @return false if the frame was not sent, the back buffer is kept for the next try
+     */
+    bool show(int8_t strip);
+
+    /**
+     * @brief Switch all pixels off, waits for the frame before to finish
+     */
+    void clear(int8_t strip);
+
+    uint16_t getNumPixels(int8_t strip) const { return strips[strip].numPixels; }
+    uint32_t getFramesShown(int8_t strip) const { return strips[strip].framesShown; }
+    uint32_t getFramesBusy(int8_t strip) const { return strips[strip].framesBusy; }
+
+private:
+    struct Strip
+    {
+        bool used;
+        uint8_t pin;
+        uint8_t back; // Buffer outputs render into, the other one may be on the wire
+        uint16_t numPixels;
+        uint32_t lastShowUs;
+        uint32_t framesShown;
+        uint32_t framesBusy; // show() calls that found the previous frame still transmitting
+        uint8_t buffers[2][WS2812_MAX_PIXELS * 3];
+    };
+
+    Strip strips[WS2812_MAX_STRIPS];
+};
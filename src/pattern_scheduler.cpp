@@ -0,0 +1,289 @@
+#include "pattern_scheduler.hpp"
+#include "logger.hpp"
+#include "task_model.hpp"
+
+PatternScheduler::PatternScheduler(LedcDriver &ledc) : ledc(ledc), runningCount(0), cursor(0), lock(portMUX_INITIALIZER_UNLOCKED), taskHandle(NULL)
+{
+    memset(outputs, 0, sizeof(outputs));
+    memset(wheel, -1, sizeof(wheel));
+    memset(groupEpochs, 0, sizeof(groupEpochs));
+    memset(groupRunning, 0, sizeof(groupRunning));
+}
+
+void PatternScheduler::start()
+{
+    xTaskCreate([](void *pvParameters) -> void
+                { static_cast<PatternScheduler *>(pvParameters)->taskHandler(); },
+                TASK_NAME_OUTPUT,
+                2048,
+                this,
+                TASK_PRIORITY_OUTPUT, // Below the control task, edges should not wait for the web server
+                &taskHandle);
+    LOG.debug("PatternScheduler", "Pattern scheduler task created");
+}
+
+int8_t PatternScheduler::add(uint8_t pin, uint8_t phaseGroup, uint16_t phaseOffsetMs, bool dimmable)
+{
+    if (phaseGroup >= PATTERN_PHASE_GROUPS)
+    {
+        LOG.errorf("PatternScheduler", "Phase group %d is out of range (0-%d)", phaseGroup, PATTERN_PHASE_GROUPS - 1);
+        return -1;
+    }
+
+    // The LEDC is set up outside the lock, a pin without a channel is switched instead
+    int8_t channel = dimmable ? ledc.attach(pin, PATTERN_PWM_FREQUENCY, PATTERN_PWM_RESOLUTION) : -1;
+    if (dimmable && channel < 0)
+    {
+        LOG.warningf("PatternScheduler", "No PWM for pin %d, levels below half are off", pin);
+    }
+
+    portENTER_CRITICAL(&lock);
+    int8_t id = -1;
+    for (int8_t i = 0; i < PATTERN_MAX_OUTPUTS; i++)
+    {
+        if (!outputs[i].used)
+        {
+            id = i;
+            break;
+        }
+    }
+
+    if (id >= 0)
+    {
+        Output &output = outputs[id];
+        output.program = nullptr;
+        output.used = true;
+        output.level = 0;
+        output.pin = pin;
+        output.phaseGroup = phaseGroup;
+        output.phaseOffsetMs = phaseOffsetMs;
+        output.channel = channel;
+        output.next = -1;
+    }
+    portEXIT_CRITICAL(&lock);
+
+    if (id < 0)
+    {
+        ledc.detach(channel);
+        LOG.errorf("PatternScheduler", "All %d pattern outputs are in use", PATTERN_MAX_OUTPUTS);
+    }
+    return id;
+}
+
+void PatternScheduler::remove(int8_t id)
+{
+    if (id < 0 || id >= PATTERN_MAX_OUTPUTS)
+    {
+        return;
+    }
+
+    setProgram(id, nullptr);
+    portENTER_CRITICAL(&lock);
+    int8_t channel = outputs[id].channel;
+    outputs[id].used = false;
+    portEXIT_CRITICAL(&lock);
+
+    ledc.detach(channel);
+}
+
+void PatternScheduler::setProgram(int8_t id, const PatternProgram *program)
+{
+    if (id < 0 || id >= PATTERN_MAX_OUTPUTS)
+    {
+        return;
+    }
+
+    bool wakeTask = false;
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&lock);
+    Output &output = outputs[id];
+    if (output.used && output.program != program)
+    {
+        if (output.program != nullptr)
+        {
+            unschedule(id);
+            if (program == nullptr)
+            {
+                groupRunning[output.phaseGroup]--;
+                runningCount--;
+            }
+        }
+        else if (program != nullptr)
+        {
+            // The first output of a group sets the group's timebase
+            if (output.phaseGroup != 0 && groupRunning[output.phaseGroup] == 0)
+            {
+                groupEpochs[output.phaseGroup] = now;
+            }
+            groupRunning[output.phaseGroup]++;
+            if (runningCount++ == 0)
+            {
+                cursor = now / PATTERN_WHEEL_RESOLUTION_MS;
+                wakeTask = true;
+            }
+        }
+
+        output.program = program;
+        if (program != nullptr)
+        {
+            start(output, now);
+            schedule(id);
+        }
+        else
+        {
+            write(output, 0);
+        }
+    }
+    portEXIT_CRITICAL(&lock);
+
+    if (wakeTask && taskHandle != NULL)
+    {
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+void PatternScheduler::start(Output &output, uint32_t now)
+{
+    // Ungrouped outputs start at their first step, grouped ones join the group's phase
+    const PatternProgram &program = *output.program;
+    uint32_t epoch = output.phaseGroup != 0 ? groupEpochs[output.phaseGroup] : now;
+    uint32_t phase = (now - epoch + output.phaseOffsetMs) % program.periodMs;
+
+    output.step = 0;
+    while (phase >= program.steps[output.step].durationMs)
+    {
+        phase -= program.steps[output.step].durationMs;
+        output.step++;
+    }
+    output.stepEndMs = now + program.steps[output.step].durationMs - phase;
+
+    refresh(output, now);
+    write(output, output.level);
+}
+
+void PatternScheduler::refresh(Output &output, uint32_t now)
+{
+    const PatternProgram &program = *output.program;
+
+    // Catch up on missed steps so the phase stays locked to the epoch
+    while ((int32_t)(output.stepEndMs - now) <= 0)
+    {
+        output.step = output.step + 1 < program.length ? output.step + 1 : 0;
+        output.stepEndMs += program.steps[output.step].durationMs;
+    }
+
+    const PatternStep &step = program.steps[output.step];
+    uint8_t level = step.level;
+    output.dueMs = output.stepEndMs;
+    if (step.fade)
+    {
+        const PatternStep &previous = program.steps[output.step > 0 ? output.step - 1 : program.length - 1];
+        uint32_t elapsed = step.durationMs - (output.stepEndMs - now);
+        level = previous.level + ((int)step.level - previous.level) * (int32_t)elapsed / step.durationMs;
+
+        // Fades are updated every wheel step until the step ends
+        if ((int32_t)(output.stepEndMs - now) > PATTERN_WHEEL_RESOLUTION_MS)
+        {
+            output.dueMs = now + PATTERN_WHEEL_RESOLUTION_MS;
+        }
+    }
+
+    if (level != output.level)
+    {
+        write(output, level);
+    }
+}
+
+void PatternScheduler::write(Output &output, uint8_t level)
+{
+    output.level = level;
+    if (output.channel >= 0)
+    {
+        ledc.write(output.channel, (level * ledc.getFullDuty(output.channel) + 127) / 255);
+    }
+    else
+    {
+        digitalWrite(output.pin, level >= 128 ? HIGH : LOW);
+    }
+}
+
+void PatternScheduler::schedule(int8_t id)
+{
+    // Round up, an edge is only handled once its whole slot has passed
+    uint8_t slot = ((outputs[id].dueMs + PATTERN_WHEEL_RESOLUTION_MS - 1) / PATTERN_WHEEL_RESOLUTION_MS) % PATTERN_WHEEL_SLOTS;
+    outputs[id].next = wheel[slot];
+    wheel[slot] = id;
+}
+
+void PatternScheduler::unschedule(int8_t id)
+{
+    uint8_t slot = ((outputs[id].dueMs + PATTERN_WHEEL_RESOLUTION_MS - 1) / PATTERN_WHEEL_RESOLUTION_MS) % PATTERN_WHEEL_SLOTS;
+    for (int8_t *link = &wheel[slot]; *link >= 0; link = &outputs[*link].next)
+    {
+        if (*link == id)
+        {
+            *link = outputs[id].next;
+            outputs[id].next = -1;
+            return;
+        }
+    }
+}
+
+void PatternScheduler::processSlot(uint8_t slot, uint32_t now)
+{
+    // Take the whole list, outputs are put back into whatever slot their next write falls in
+    int8_t id = wheel[slot];
+    wheel[slot] = -1;
+
+    while (id >= 0)
+    {
+        Output &output = outputs[id];
+        int8_t next = output.next;
+
+        // Outputs due in a later turn of the wheel stay where they are
+        if ((int32_t)(output.dueMs - now) <= 0)
+        {
+            refresh(output, now);
+        }
+
+        schedule(id);
+        id = next;
+    }
+}
+
+void PatternScheduler::advance(uint32_t now)
+{
+    uint32_t target = now / PATTERN_WHEEL_RESOLUTION_MS;
+
+    portENTER_CRITICAL(&lock);
+    // After a stall longer than one turn every slot only needs a single look
+    if (target - cursor > PATTERN_WHEEL_SLOTS)
+    {
+        cursor = target - PATTERN_WHEEL_SLOTS;
+    }
+    while (cursor != target)
+    {
+        cursor++;
+        processSlot(cursor % PATTERN_WHEEL_SLOTS, now);
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void PatternScheduler::taskHandler()
+{
+    TickType_t lastWakeTime = xTaskGetTickCount();
+
+    while (true)
+    {
+        if (runningCount == 0)
+        {
+            // Nothing runs, sleep until setProgram() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            lastWakeTime = xTaskGetTickCount();
+        }
+
+        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(PATTERN_WHEEL_RESOLUTION_MS));
+        advance(millis());
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Arduino.h>
+#include "const.hpp"
+#include "channel-handlers/patternProgram.hpp"
+#include "outputs/ledc_driver.hpp"
+
+// Edges are sorted into PATTERN_WHEEL_SLOTS buckets of PATTERN_WHEEL_RESOLUTION_MS each,
+// edges further out than one turn of the wheel wait in their bucket for later turns
+#define PATTERN_WHEEL_SLOTS 64
+#define PATTERN_WHEEL_RESOLUTION_MS 5
+#define PATTERN_MAX_OUTPUTS MAX_CHANNEL_HANDLERS
+#define PATTERN_PHASE_GROUPS 8 // Group 0 does not share its timebase
+// LEDC timer for dimmable outputs, shared with the status LED
+#define PATTERN_PWM_FREQUENCY 1000
+#define PATTERN_PWM_RESOLUTION 8
+
+/**
+ * @brief Steps the pattern programs of all blinking and sequenced outputs from one task
+ *
+ * Each step's end is computed from the previous one rather than from when the task
+ * woke up, so outputs do not drift. Outputs in the same phase group take their
+ * phase from a common epoch, set when the first of them starts a pattern, so
+ * turn signals and hazards switch together and chasers stay lined up.
+ *
+ * All pin writes happen under the scheduler's lock, once remove() or
+ * setProgram(nullptr) returned the pin is not written by the scheduler any more.
+ */
+class PatternScheduler
+{
+public:
+    PatternScheduler(LedcDriver &ledc);
+
+    /**
+     * @brief Create the scheduler task
+     */
+    void start();
+
+    /**
+     * @brief Register an output, it stays off until setProgram()
+     * @param phaseGroup 1..PATTERN_PHASE_GROUPS-1 to share the timebase with other outputs, 0 for none
+     * @param phaseOffsetMs How far this output runs ahead of the group's timebase
+     * @param dimmable Write levels through an LEDC channel, otherwise (or if no channel is free) the pin is switched at half level
+     * @return Id of the output, -1 if all outputs are in use
+     */
+    int8_t add(uint8_t pin, uint8_t phaseGroup, uint16_t phaseOffsetMs, bool dimmable);
+
+    /**
+     * @brief Stop an output, switch it off and free its id
+     */
+    void remove(int8_t id);
+
+    /**
+     * @brief Run a program on an output, nullptr switches it off
+     * A new program starts at the phase the output's group is in.
+     */
+    void setProgram(int8_t id, const PatternProgram *program);
+
+    /**
+     * @brief Handle all edges due up to now, called by the scheduler task every wheel step
+     */
+    void advance(uint32_t now);
+
+    uint8_t getRunningCount() const { return runningCount; }
+
+private:
+    struct Output
+    {
+        const PatternProgram *program; // nullptr while off
+        uint32_t stepEndMs;            // millis() the current step ends
+        uint32_t dueMs;                // millis() the output needs its next write
+        uint16_t phaseOffsetMs;
+        uint8_t pin;
+        uint8_t phaseGroup;
+        uint8_t step;
+        uint8_t level;
+        bool used;
+        int8_t channel; // LEDC channel of dimmable outputs, -1 for switched ones
+        int8_t next; // Next output in the same wheel slot, -1 at the end
+    };
+
+    LedcDriver &ledc;
+    Output outputs[PATTERN_MAX_OUTPUTS];
+    int8_t wheel[PATTERN_WHEEL_SLOTS]; // First output per slot, -1 if empty
+    uint32_t groupEpochs[PATTERN_PHASE_GROUPS];
+    uint8_t groupRunning[PATTERN_PHASE_GROUPS];
+    volatile uint8_t runningCount;
+    uint32_t cursor; // Last wheel step (millis() / PATTERN_WHEEL_RESOLUTION_MS) that was processed
+    portMUX_TYPE lock;
+    TaskHandle_t taskHandle;
+
+    void start(Output &output, uint32_t now);
+    void refresh(Output &output, uint32_t now);
+    void write(Output &output, uint8_t level);
+    void schedule(int8_t id);
+    void unschedule(int8_t id);
+    void processSlot(uint8_t slot, uint32_t now);
+    void taskHandler();
+};
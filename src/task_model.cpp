@@ -0,0 +1,177 @@
+#include "task_model.hpp"
+#include "logger.hpp"
+
+struct TaskModelEntry
+{
+    const char *name;      // Prefix of the task name, ESP-IDF numbers some tasks per core
+    int8_t priority;       // Tier the task has to run at, -1 for tasks we do not create
+    uint8_t budgetPercent; // 0 if the task has no budget
+    bool preemptsControl;  // May run above the control task, only for tasks that run for microseconds
+};
+
+static const TaskModelEntry TASK_MODEL[] = {
+    {TASK_NAME_CONTROL, TASK_PRIORITY_CONTROL, TASK_BUDGET_CONTROL_PERCENT, false},
+    {TASK_NAME_CAPTURE, TASK_PRIORITY_CONTROL, TASK_BUDGET_CAPTURE_PERCENT, false},
+    {TASK_NAME_OUTPUT, TASK_PRIORITY_OUTPUT, TASK_BUDGET_OUTPUT_PERCENT, false},
+    {TASK_NAME_SAMPLING, TASK_PRIORITY_SAMPLING, TASK_BUDGET_SAMPLING_PERCENT, false},
+    {TASK_NAME_NETWORK, TASK_PRIORITY_NETWORK, TASK_BUDGET_NETWORK_PERCENT, false},
+    {TASK_NAME_TELEMETRY, TASK_PRIORITY_TELEMETRY, TASK_BUDGET_TELEMETRY_PERCENT, false},
+    {TASK_NAME_WEB, TASK_PRIORITY_NETWORK, TASK_BUDGET_WEB_PERCENT, false},
+
+    // Created by ESP-IDF, Arduino and libraries
+    {"loopTask", -1, TASK_BUDGET_TELEMETRY_PERCENT, false}, // Arduino loop, runs the task monitor
+    {"IDLE", -1, 0, false},
+    {"Tmr Svc", -1, 0, false},
+    {"esp_timer", -1, 0, true},        // Status LED steps
+    {"uart_event_task", -1, 0, true},  // Wakes the control task at the end of a frame
+    {"ipc", -1, 0, true},
+    {"wifi", -1, 0, true},
+    {"tiT", -1, 0, true},              // lwIP
+    {"sys_evt", -1, 0, true},
+};
+static const uint8_t TASK_MODEL_SIZE = sizeof(TASK_MODEL) / sizeof(TASK_MODEL[0]);
+static_assert(TASK_MODEL_SIZE <= 32, "Budget overruns are tracked in a 32 bit mask");
+static_assert(TASK_MODEL_SIZE <= TASK_MONITOR_MAX_TASKS, "Run times are kept per model entry");
+
+static int8_t findModelEntry(const char *taskName)
+{
+    for (uint8_t i = 0; i < TASK_MODEL_SIZE; i++)
+    {
+        if (strncmp(taskName, TASK_MODEL[i].name, strlen(TASK_MODEL[i].name)) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+TaskMonitor::TaskMonitor() : checkedTaskCount(0), windowStart(0), violations(0), reported(0)
+{
+#if configGENERATE_RUN_TIME_STATS
+    memset(lastRunTime, 0, sizeof(lastRunTime));
+    lastTotalRunTime = 0;
+#endif
+}
+
+void TaskMonitor::begin()
+{
+    checkTasks();
+#if configGENERATE_RUN_TIME_STATS
+    checkBudgets(); // Only takes the first readings
+#else
+    LOG.info("TaskMonitor", "FreeRTOS keeps no run time stats, CPU budgets are not checked");
+#endif
+    windowStart = millis();
+}
+
+void TaskMonitor::update(unsigned long currentTime)
+{
+    if (uxTaskGetNumberOfTasks() != checkedTaskCount)
+    {
+        checkTasks();
+    }
+
+#if configGENERATE_RUN_TIME_STATS
+    if (currentTime - windowStart >= TASK_BUDGET_WINDOW_MS)
+    {
+        windowStart = currentTime;
+        checkBudgets();
+    }
+#endif
+}
+
+void TaskMonitor::checkTasks()
+{
+    TaskStatus_t tasks[TASK_MONITOR_MAX_TASKS];
+    checkedTaskCount = uxTaskGetNumberOfTasks();
+    UBaseType_t count = uxTaskGetSystemState(tasks, TASK_MONITOR_MAX_TASKS, NULL);
+    if (count == 0)
+    {
+        LOG.errorf("TaskMonitor", "%d tasks are running, only %d can be checked", checkedTaskCount, TASK_MONITOR_MAX_TASKS);
+        violations++;
+        return;
+    }
+
+    uint32_t found = violations;
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t &task = tasks[i];
+        int8_t entry = findModelEntry(task.pcTaskName);
+        if (entry < 0)
+        {
+            LOG.warningf("TaskMonitor", "Task %s at priority %d is not part of the task model",
+                         task.pcTaskName, task.uxBasePriority);
+            violations++;
+            continue;
+        }
+
+        const TaskModelEntry &model = TASK_MODEL[entry];
+        if (model.priority >= 0 && task.uxBasePriority != (UBaseType_t)model.priority)
+        {
+            LOG.warningf("TaskMonitor", "Task %s runs at priority %d instead of its tier %d",
+                         task.pcTaskName, task.uxBasePriority, model.priority);
+            violations++;
+        }
+        else if (model.priority < 0 && !model.preemptsControl && task.uxBasePriority >= TASK_PRIORITY_CONTROL)
+        {
+            LOG.warningf("TaskMonitor", "Task %s at priority %d competes with the control task",
+                         task.pcTaskName, task.uxBasePriority);
+            violations++;
+        }
+
+        // ESP-IDF reports the high water mark in bytes
+        if (task.usStackHighWaterMark < TASK_MONITOR_MIN_FREE_STACK)
+        {
+            LOG.warningf("TaskMonitor", "Task %s has only %d bytes of stack left", task.pcTaskName, task.usStackHighWaterMark);
+            violations++;
+        }
+    }
+
+    if (violations == found)
+    {
+        LOG.infof("TaskMonitor", "All %d tasks match the task model", count);
+    }
+}
+
+#if configGENERATE_RUN_TIME_STATS
+void TaskMonitor::checkBudgets()
+{
+    TaskStatus_t tasks[TASK_MONITOR_MAX_TASKS];
+    uint32_t totalRunTime = 0;
+    UBaseType_t count = uxTaskGetSystemState(tasks, TASK_MONITOR_MAX_TASKS, &totalRunTime);
+    uint32_t elapsed = totalRunTime - lastTotalRunTime;
+    bool firstWindow = lastTotalRunTime == 0;
+    lastTotalRunTime = totalRunTime;
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        int8_t entry = findModelEntry(tasks[i].pcTaskName);
+        if (entry < 0 || TASK_MODEL[entry].budgetPercent == 0)
+        {
+            continue;
+        }
+
+        uint32_t used = tasks[i].ulRunTimeCounter - lastRunTime[entry];
+        lastRunTime[entry] = tasks[i].ulRunTimeCounter;
+        if (firstWindow || elapsed == 0)
+        {
+            continue;
+        }
+
+        uint32_t percent = (uint64_t)used * 100 / elapsed;
+        uint32_t bit = 1UL << entry;
+        if (percent <= TASK_MODEL[entry].budgetPercent)
+        {
+            reported &= ~bit;
+        }
+        else if (!(reported & bit))
+        {
+            // Logged once per overrun, not every window it lasts
+            LOG.warningf("TaskMonitor", "Task %s used %lu%% of the CPU, its budget is %d%%",
+                         tasks[i].pcTaskName, percent, TASK_MODEL[entry].budgetPercent);
+            reported |= bit;
+            violations++;
+        }
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Priority tiers, a higher tier preempts a lower one. The ESP32-C3 has a single core,
+// so everything that moves outputs sits above everything that talks to the network:
+// a slow SPIFFS mount or a WiFi restart must never hold back a servo.
+#define TASK_PRIORITY_CONTROL 5   // Control loop, and the PPM capture that feeds it
+#define TASK_PRIORITY_OUTPUT 4    // Pattern scheduler, edges of blinking outputs
+#define TASK_PRIORITY_SAMPLING 3  // ADC sampler, only has to keep up with the DMA buffer
+#define TASK_PRIORITY_NETWORK 2   // WiFi, web requests and configuration
+#define TASK_PRIORITY_TELEMETRY 1 // Web telemetry and the Arduino loop, whatever time is left
+
+// Share of the CPU each task may use, checked over TASK_BUDGET_WINDOW_MS when
+// FreeRTOS keeps run time stats. The control task's tick also has to fit the loop
+// interval, which BoardComputer counts as tick overruns.
+#define TASK_BUDGET_CONTROL_PERCENT 30
+#define TASK_BUDGET_CAPTURE_PERCENT 2
+#define TASK_BUDGET_OUTPUT_PERCENT 5
+#define TASK_BUDGET_SAMPLING_PERCENT 5
+#define TASK_BUDGET_NETWORK_PERCENT 25
+#define TASK_BUDGET_WEB_PERCENT 20 // Parsing a posted config and writing it to EEPROM
+#define TASK_BUDGET_TELEMETRY_PERCENT 10
+#define TASK_BUDGET_WINDOW_MS 5000
+
+// Names the tasks are created with, the model finds them by name
+#define TASK_NAME_CONTROL "BoardComputer"
+#define TASK_NAME_CAPTURE "PpmDecoder"
+#define TASK_NAME_OUTPUT "PatternScheduler"
+#define TASK_NAME_SAMPLING "AdcSampler"
+#define TASK_NAME_NETWORK "NetworkManager"
+#define TASK_NAME_TELEMETRY "TelemetryTask"
+// Created by AsyncTCP at a fixed priority above the network tier, NetworkManager
+// moves it down once the web server started it
+#define TASK_NAME_WEB "async_tcp"
+
+// Tasks the self-check can look at, more are reported as a problem
+#define TASK_MONITOR_MAX_TASKS 24
+// Free stack below which a task is reported
+#define TASK_MONITOR_MIN_FREE_STACK 512
+
+/**
+ * @brief Checks the running tasks against the task model
+ *
+ * Every task has to be in the model: ours with their tier and CPU budget, and the
+ * ones ESP-IDF, Arduino and the libraries create with whether they may preempt the
+ * control task. The check runs at startup and again whenever the number of tasks
+ * changes, since the network stack starts its tasks later. With run time stats
+ * enabled the CPU share of every budgeted task is checked once per window.
+ */
+class TaskMonitor
+{
+public:
+    TaskMonitor();
+
+    /**
+     * @brief Check the tasks running now, called once all tasks of setup() exist
+     */
+    void begin();
+
+    /**
+     * @brief Recheck new tasks and the CPU budgets, called from the Arduino loop
+     */
+    void update(unsigned long currentTime);
+
+    /**
+     * @brief Problems found since boot: unknown tasks, wrong tiers, low stacks and budget overruns
+     */
+    uint32_t getViolations() const { return violations; }
+
+private:
+    UBaseType_t checkedTaskCount;
+    unsigned long windowStart;
+    uint32_t violations;
+    uint32_t reported; // Bit per model entry whose budget overrun was logged, cleared once it is back in budget
+#if configGENERATE_RUN_TIME_STATS
+    uint32_t lastRunTime[TASK_MONITOR_MAX_TASKS]; // By model entry
+    uint32_t lastTotalRunTime;
+#endif
+
+    void checkTasks();
+    void checkBudgets();
+};
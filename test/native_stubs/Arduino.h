@@ -0,0 +1,114 @@
+#pragma once
+
+// Just enough of the Arduino core and FreeRTOS for the decoders to build on the host,
+// see [env:native]. Nothing here talks to hardware, tests feed the decoders directly.
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Every call moves the clock on by a millisecond, so frame gaps and timestamps are never 0
+inline unsigned long micros()
+{
+    static unsigned long now = 0;
+    return now += 1000;
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t written = 0;
+        while (written < size && write(buffer[written]))
+        {
+            written++;
+        }
+        return written;
+    }
+    size_t printf(const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        int length = vprintf(format, args);
+        va_end(args);
+        return length > 0 ? length : 0;
+    }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+    virtual size_t readBytes(char *buffer, size_t length)
+    {
+        size_t count = 0;
+        int value;
+        while (count < length && (value = read()) >= 0)
+        {
+            buffer[count++] = (char)value;
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t value) override { return fputc(value, stdout) == EOF ? 0 : 1; }
+    operator bool() const { return true; }
+};
+inline HardwareSerial Serial;
+
+class EspClass
+{
+public:
+    uint32_t getCycleCount() { return 0; }
+};
+inline EspClass ESP;
+
+// FreeRTOS, single threaded on the host
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef int portMUX_TYPE;
+
+#define pdTRUE 1
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+inline BaseType_t xTaskCreate(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *handle)
+{
+    *handle = nullptr;
+    return pdPASS;
+}
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline void vTaskDelay(TickType_t) {}
@@ -0,0 +1,77 @@
+#pragma once
+
+// RMT receive API as far as PpmDecoder uses it. Setting up a channel always fails,
+// tests hand captured items to PpmDecoder::decodeFrame() instead.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_NOT_SUPPORTED 0x106
+
+inline const char *esp_err_to_name(esp_err_t) { return "ESP_ERR_NOT_SUPPORTED"; }
+
+typedef int gpio_num_t;
+
+typedef enum
+{
+    RMT_CHANNEL_0,
+    RMT_CHANNEL_1,
+    RMT_CHANNEL_2,
+    RMT_CHANNEL_3,
+} rmt_channel_t;
+
+// Same layout as the ESP-IDF item, captures can be stored as plain words
+typedef struct
+{
+    union
+    {
+        struct
+        {
+            uint32_t duration0 : 15;
+            uint32_t level0 : 1;
+            uint32_t duration1 : 15;
+            uint32_t level1 : 1;
+        };
+        uint32_t val;
+    };
+} rmt_item32_t;
+
+typedef struct
+{
+    uint16_t idle_threshold;
+} rmt_rx_config_t;
+
+typedef struct
+{
+    rmt_channel_t channel;
+    gpio_num_t gpio_num;
+    rmt_rx_config_t rx_config;
+} rmt_config_t;
+
+#define RMT_DEFAULT_CONFIG_RX(gpio, channel_id) \
+    {                                           \
+        .channel = channel_id,                  \
+        .gpio_num = gpio,                       \
+        .rx_config = {.idle_threshold = 12000}, \
+    }
+
+typedef void *RingbufHandle_t;
+
+inline esp_err_t rmt_config(const rmt_config_t *) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t rmt_driver_install(rmt_channel_t, size_t, int) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t rmt_driver_uninstall(rmt_channel_t) { return ESP_OK; }
+inline esp_err_t rmt_get_ringbuf_handle(rmt_channel_t, RingbufHandle_t *handle)
+{
+    *handle = nullptr;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t rmt_rx_start(rmt_channel_t, bool) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t rmt_rx_stop(rmt_channel_t) { return ESP_OK; }
+inline void *xRingbufferReceive(RingbufHandle_t, size_t *length, uint32_t)
+{
+    *length = 0;
+    return nullptr;
+}
+inline void vRingbufferReturnItem(RingbufHandle_t, void *) {}
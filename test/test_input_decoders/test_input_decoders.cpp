@@ -0,0 +1,313 @@
+#include <unity.h>
+#include "benchmarks/input_sample_streams.hpp"
+#include "inputs/sbus_decoder.hpp"
+#include "inputs/ibus_decoder.hpp"
+#include "inputs/ppm_decoder.hpp"
+
+/**
+ * @brief Hands the decoders a buffer the way a UART would
+ */
+class ReplayStream : public Stream
+{
+public:
+    ReplayStream() : data(nullptr), length(0), position(0) {}
+
+    void load(const uint8_t *data, size_t length)
+    {
+        this->data = data;
+        this->length = length;
+        this->position = 0;
+    }
+
+    int available() override { return length - position; }
+    int read() override { return position < length ? data[position++] : -1; }
+    int peek() override { return position < length ? data[position] : -1; }
+    size_t readBytes(char *buffer, size_t count) override
+    {
+        count = min(count, length - position);
+        memcpy(buffer, data + position, count);
+        position += count;
+        return count;
+    }
+    size_t write(uint8_t) override { return 1; }
+
+private:
+    const uint8_t *data;
+    size_t length;
+    size_t position;
+};
+
+static const size_t SBUS_SAMPLE_FRAME_SIZE = sizeof(SBUS_SAMPLE_STREAM) / INPUT_SAMPLE_FRAMES;
+static const size_t IBUS_SAMPLE_FRAME_SIZE = sizeof(IBUS_SAMPLE_STREAM) / INPUT_SAMPLE_FRAMES;
+static const rmt_item32_t *const PPM_SAMPLE = reinterpret_cast<const rmt_item32_t *>(PPM_SAMPLE_ITEMS);
+
+static ReplayStream stream;
+static uint16_t channels[INPUT_MAX_CHANNELS];
+
+void setUp()
+{
+    for (uint8_t i = 0; i < INPUT_MAX_CHANNELS; i++)
+    {
+        channels[i] = CHANNEL_MID;
+    }
+}
+
+void tearDown()
+{
+}
+
+static void test_recordings_hold_whole_frames()
+{
+    TEST_ASSERT_EQUAL(SBUS_FRAME_SIZE * INPUT_SAMPLE_FRAMES, sizeof(SBUS_SAMPLE_STREAM));
+    TEST_ASSERT_EQUAL(IBUS_FRAME_SIZE * INPUT_SAMPLE_FRAMES, sizeof(IBUS_SAMPLE_STREAM));
+    TEST_ASSERT_EQUAL(PPM_SAMPLE_ITEMS_PER_FRAME * INPUT_SAMPLE_FRAMES, sizeof(PPM_SAMPLE_ITEMS) / sizeof(uint32_t));
+}
+
+static void test_sbus_recording_decodes_every_frame()
+{
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(SBUS_SAMPLE_STREAM, sizeof(SBUS_SAMPLE_STREAM));
+    decoder.update();
+
+    InputDecoderStats stats = decoder.getStats();
+    TEST_ASSERT_EQUAL_UINT32(INPUT_SAMPLE_FRAMES, stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytesDiscarded);
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.getFailsafeFrames());
+    TEST_ASSERT_NOT_EQUAL(0, decoder.getLastChannelsTime());
+}
+
+static void test_ibus_recording_decodes_every_frame()
+{
+    IbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(IBUS_SAMPLE_STREAM, sizeof(IBUS_SAMPLE_STREAM));
+    decoder.update();
+
+    InputDecoderStats stats = decoder.getStats();
+    TEST_ASSERT_EQUAL_UINT32(INPUT_SAMPLE_FRAMES, stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.crcErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytesDiscarded);
+}
+
+static void test_ppm_recording_decodes_every_frame()
+{
+    uint16_t widths[INPUT_MAX_CHANNELS];
+    for (size_t frame = 0; frame < INPUT_SAMPLE_FRAMES; frame++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(INPUT_SAMPLE_CHANNELS,
+                                PpmDecoder::decodeFrame(PPM_SAMPLE + frame * PPM_SAMPLE_ITEMS_PER_FRAME,
+                                                        PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+    }
+}
+
+static void test_recordings_agree_frame_by_frame()
+{
+    // SBUS only resolves the sticks to about a microsecond, iBUS and PPM carry them exactly
+    uint16_t sbusChannels[INPUT_MAX_CHANNELS] = {0};
+    uint16_t ibusChannels[INPUT_MAX_CHANNELS] = {0};
+    uint16_t ppmWidths[INPUT_MAX_CHANNELS] = {0};
+    ReplayStream ibusStream;
+    SbusDecoder sbus;
+    IbusDecoder ibus;
+    sbus.begin(stream, sbusChannels);
+    ibus.begin(ibusStream, ibusChannels);
+
+    for (size_t frame = 0; frame < INPUT_SAMPLE_FRAMES; frame++)
+    {
+        stream.load(SBUS_SAMPLE_STREAM + frame * SBUS_SAMPLE_FRAME_SIZE, SBUS_SAMPLE_FRAME_SIZE);
+        sbus.update();
+        ibusStream.load(IBUS_SAMPLE_STREAM + frame * IBUS_SAMPLE_FRAME_SIZE, IBUS_SAMPLE_FRAME_SIZE);
+        ibus.update();
+        PpmDecoder::decodeFrame(PPM_SAMPLE + frame * PPM_SAMPLE_ITEMS_PER_FRAME, PPM_SAMPLE_ITEMS_PER_FRAME, ppmWidths);
+
+        for (uint8_t i = 0; i < INPUT_SAMPLE_CHANNELS; i++)
+        {
+            TEST_ASSERT_EQUAL_UINT16(ibusChannels[i], constrain(ppmWidths[i], CHANNEL_MIN, CHANNEL_MAX));
+            TEST_ASSERT_UINT16_WITHIN(1, ibusChannels[i], sbusChannels[i]);
+        }
+    }
+}
+
+static void test_sbus_frame_split_across_updates()
+{
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(SBUS_SAMPLE_STREAM, 10);
+    decoder.update();
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.getStats().framesDecoded);
+
+    stream.load(SBUS_SAMPLE_STREAM + 10, SBUS_FRAME_SIZE - 10);
+    decoder.update();
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getStats().framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.getStats().bytesDiscarded);
+}
+
+static void test_sbus_skips_garbage_before_a_frame()
+{
+    uint8_t data[3 + SBUS_FRAME_SIZE] = {0x0F, 0x55, 0x00};
+    memcpy(data + 3, SBUS_SAMPLE_STREAM, SBUS_FRAME_SIZE);
+
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(data, sizeof(data));
+    decoder.update();
+
+    InputDecoderStats stats = decoder.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.bytesDiscarded);
+}
+
+static void test_sbus_discards_frame_with_corrupted_end_byte()
+{
+    uint8_t data[2 * SBUS_FRAME_SIZE];
+    memcpy(data, SBUS_SAMPLE_STREAM, sizeof(data));
+    data[SBUS_FRAME_SIZE - 1] = 0x55;
+
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(data, sizeof(data));
+    decoder.update();
+
+    // The whole broken frame is skipped, the next one still decodes
+    InputDecoderStats stats = decoder.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(SBUS_FRAME_SIZE, stats.bytesDiscarded);
+}
+
+static void test_sbus_accepts_sbus2_end_byte()
+{
+    uint8_t data[SBUS_FRAME_SIZE];
+    memcpy(data, SBUS_SAMPLE_STREAM, sizeof(data));
+    data[SBUS_FRAME_SIZE - 1] = 0x14;
+
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(data, sizeof(data));
+    decoder.update();
+
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getStats().framesDecoded);
+    TEST_ASSERT_NOT_EQUAL(0, decoder.getLastChannelsTime());
+}
+
+static void test_sbus_failsafe_frame_keeps_channels()
+{
+    uint8_t data[SBUS_FRAME_SIZE];
+    memcpy(data, SBUS_SAMPLE_STREAM, sizeof(data));
+    data[23] |= 0x08;
+
+    SbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(data, sizeof(data));
+    decoder.update();
+
+    // Counted, but the board's own failsafe has to take over
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getStats().framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getFailsafeFrames());
+    TEST_ASSERT_EQUAL(0, decoder.getLastChannelsTime());
+    TEST_ASSERT_EQUAL_UINT16(0, decoder.takeChangedChannels());
+    for (uint8_t i = 0; i < INPUT_MAX_CHANNELS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT16(CHANNEL_MID, channels[i]);
+    }
+}
+
+static void test_ibus_rejects_corrupted_checksum()
+{
+    uint8_t data[2 * IBUS_FRAME_SIZE];
+    memcpy(data, IBUS_SAMPLE_STREAM, sizeof(data));
+    data[2] ^= 0x01;
+
+    IbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(data, sizeof(data));
+    decoder.update();
+
+    InputDecoderStats stats = decoder.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.framesDecoded);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.crcErrors);
+    TEST_ASSERT_EQUAL_UINT32(IBUS_FRAME_SIZE, stats.bytesDiscarded);
+}
+
+static void test_ibus_leaves_channels_15_and_16_alone()
+{
+    IbusDecoder decoder;
+    decoder.begin(stream, channels);
+    stream.load(IBUS_SAMPLE_STREAM, IBUS_FRAME_SIZE);
+    decoder.update();
+
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getStats().framesDecoded);
+    TEST_ASSERT_EQUAL_UINT16(CHANNEL_MID, channels[14]);
+    TEST_ASSERT_EQUAL_UINT16(CHANNEL_MID, channels[15]);
+    TEST_ASSERT_EQUAL_UINT16(0, decoder.takeChangedChannels() & 0xC000);
+}
+
+static void test_ppm_rejects_out_of_range_pulses()
+{
+    rmt_item32_t items[PPM_SAMPLE_ITEMS_PER_FRAME];
+    uint16_t widths[INPUT_MAX_CHANNELS];
+
+    memcpy(items, PPM_SAMPLE, sizeof(items));
+    items[2].duration1 = PPM_MAX_CHANNEL_US - items[2].duration0 + 1;
+    TEST_ASSERT_EQUAL_UINT8(0, PpmDecoder::decodeFrame(items, PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+
+    memcpy(items, PPM_SAMPLE, sizeof(items));
+    items[2].duration1 = PPM_MIN_CHANNEL_US - items[2].duration0 - 1;
+    TEST_ASSERT_EQUAL_UINT8(0, PpmDecoder::decodeFrame(items, PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+
+    // The limits themselves are still channels
+    memcpy(items, PPM_SAMPLE, sizeof(items));
+    items[2].duration1 = PPM_MAX_CHANNEL_US - items[2].duration0;
+    items[3].duration1 = PPM_MIN_CHANNEL_US - items[3].duration0;
+    TEST_ASSERT_EQUAL_UINT8(INPUT_SAMPLE_CHANNELS, PpmDecoder::decodeFrame(items, PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+    TEST_ASSERT_EQUAL_UINT16(PPM_MAX_CHANNEL_US, widths[2]);
+    TEST_ASSERT_EQUAL_UINT16(PPM_MIN_CHANNEL_US, widths[3]);
+}
+
+static void test_ppm_needs_minimum_channels()
+{
+    rmt_item32_t items[PPM_SAMPLE_ITEMS_PER_FRAME];
+    uint16_t widths[INPUT_MAX_CHANNELS];
+
+    // A zero duration ends the frame after the channels before it
+    memcpy(items, PPM_SAMPLE, sizeof(items));
+    items[PPM_MIN_CHANNELS].duration0 = 0;
+    TEST_ASSERT_EQUAL_UINT8(PPM_MIN_CHANNELS, PpmDecoder::decodeFrame(items, PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+
+    items[PPM_MIN_CHANNELS - 1].duration0 = 0;
+    TEST_ASSERT_EQUAL_UINT8(0, PpmDecoder::decodeFrame(items, PPM_SAMPLE_ITEMS_PER_FRAME, widths));
+}
+
+static void test_ppm_rejects_too_many_channels()
+{
+    rmt_item32_t items[INPUT_MAX_CHANNELS + 1];
+    uint16_t widths[INPUT_MAX_CHANNELS];
+    for (uint8_t i = 0; i < INPUT_MAX_CHANNELS + 1; i++)
+    {
+        items[i] = PPM_SAMPLE[0];
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(INPUT_MAX_CHANNELS, PpmDecoder::decodeFrame(items, INPUT_MAX_CHANNELS, widths));
+    TEST_ASSERT_EQUAL_UINT8(0, PpmDecoder::decodeFrame(items, INPUT_MAX_CHANNELS + 1, widths));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_recordings_hold_whole_frames);
+    RUN_TEST(test_sbus_recording_decodes_every_frame);
+    RUN_TEST(test_ibus_recording_decodes_every_frame);
+    RUN_TEST(test_ppm_recording_decodes_every_frame);
+    RUN_TEST(test_recordings_agree_frame_by_frame);
+    RUN_TEST(test_sbus_frame_split_across_updates);
+    RUN_TEST(test_sbus_skips_garbage_before_a_frame);
+    RUN_TEST(test_sbus_discards_frame_with_corrupted_end_byte);
+    RUN_TEST(test_sbus_accepts_sbus2_end_byte);
+    RUN_TEST(test_sbus_failsafe_frame_keeps_channels);
+    RUN_TEST(test_ibus_rejects_corrupted_checksum);
+    RUN_TEST(test_ibus_leaves_channels_15_and_16_alone);
+    RUN_TEST(test_ppm_rejects_out_of_range_pulses);
+    RUN_TEST(test_ppm_needs_minimum_channels);
+    RUN_TEST(test_ppm_rejects_too_many_channels);
+    return UNITY_END();
+}